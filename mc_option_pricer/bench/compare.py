@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+"""Compare two mc_bench JSON result files and flag regressions.
+
+Usage:
+    ./mc_bench --benchmark_out=base.json --benchmark_out_format=json
+    ./mc_bench --benchmark_out=new.json  --benchmark_out_format=json
+    python3 bench/compare.py base.json new.json [--threshold 0.05]
+
+Benchmarks are matched by name. When a file was produced with
+--benchmark_repetitions, the median aggregate is used. The script exits
+with status 1 if any benchmark's real time grew by more than the
+threshold (a fraction, default 5%).
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_times(path):
+    with open(path) as f:
+        data = json.load(f)
+    times = {}
+    medians = {}
+    for bench in data.get("benchmarks", []):
+        if bench.get("run_type") == "aggregate":
+            if bench.get("aggregate_name") == "median":
+                medians[bench["run_name"]] = bench["real_time"]
+            continue
+        times.setdefault(bench.get("run_name", bench["name"]), bench["real_time"])
+    times.update(medians)
+    return times
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline")
+    parser.add_argument("contender")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="relative slowdown treated as a regression")
+    args = parser.parse_args()
+
+    base = load_times(args.baseline)
+    new = load_times(args.contender)
+
+    regressions = 0
+    width = max((len(name) for name in base), default=10)
+    print(f"{'Benchmark':<{width}}  {'base':>12}  {'new':>12}  {'change':>8}")
+    for name in sorted(base):
+        if name not in new:
+            print(f"{name:<{width}}  {base[name]:>12.4g}  {'missing':>12}")
+            continue
+        change = new[name] / base[name] - 1.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        print(f"{name:<{width}}  {base[name]:>12.4g}  {new[name]:>12.4g}  {change:>+8.1%}{flag}")
+    for name in sorted(set(new) - set(base)):
+        print(f"{name:<{width}}  {'new':>12}  {new[name]:>12.4g}")
+
+    print(f"\n{regressions} regression(s) above {args.threshold:.0%}")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
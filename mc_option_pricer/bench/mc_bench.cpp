@@ -0,0 +1,479 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "black_scholes.hpp"
+#include "gbm.hpp"
+#include "greeks.hpp"
+#include "importance_sampling.hpp"
+#include "local_vol.hpp"
+#include "maturity_surface.hpp"
+#include "mixed_precision.hpp"
+#include "mlmc.hpp"
+#include "path_store.hpp"
+#include "pde_solver.hpp"
+#include "pricer.hpp"
+#include "pricing_context.hpp"
+#include "pricing_plan.hpp"
+#include "random_utils.hpp"
+#include "reduction_tree.hpp"
+#include "result_cache.hpp"
+#include "scenario_grid.hpp"
+#include "stratified_sampling.hpp"
+#include "term_structure.hpp"
+#include "unit_path_cache.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Microbenchmarks for the pricing kernels.
+//
+// Engine benchmarks take (paths, steps, threads) arguments. Results are
+// emitted in Google Benchmark's JSON format with
+//   ./mc_bench --benchmark_out=bench.json --benchmark_out_format=json
+// and two result files can be compared with bench/compare.py.
+
+namespace {
+
+const double kS0 = 100.0;
+const double kK = 100.0;
+const double kR = 0.05;
+const double kSigma = 0.2;
+const double kT = 1.0;
+
+// Sets the OpenMP thread count for the lifetime of a benchmark run
+class ThreadScope {
+public:
+    explicit ThreadScope(int threads) {
+#ifdef _OPENMP
+        previous = omp_get_max_threads();
+        omp_set_num_threads(threads);
+#else
+        (void)threads;
+#endif
+    }
+    ~ThreadScope() {
+#ifdef _OPENMP
+        omp_set_num_threads(previous);
+#endif
+    }
+
+private:
+    int previous = 1;
+};
+
+// (paths, steps, threads) grid shared by the engine benchmarks
+void engine_args(benchmark::internal::Benchmark* b) {
+    std::vector<std::int64_t> threads = {1};
+#ifdef _OPENMP
+    for (int t = 2; t <= omp_get_num_procs(); t *= 2) {
+        threads.push_back(t);
+    }
+#endif
+    b->ArgsProduct({{1 << 12, 1 << 15}, {1, 52, 252}, threads})
+        ->ArgNames({"paths", "steps", "threads"})
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+}
+
+void set_engine_counters(benchmark::State& state) {
+    double paths = static_cast<double>(state.range(0));
+    double steps = static_cast<double>(state.range(1));
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * paths));
+    state.counters["path_steps_per_s"] = benchmark::Counter(
+        paths * steps * static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+
+GBMParams engine_params(const benchmark::State& state) {
+    GBMParams p = {kS0, kSigma, kT, static_cast<int>(state.range(1))};
+    return p;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Random number generation
+
+static void BM_randn(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(randn());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_randn);
+
+static void BM_RngStream_normal(benchmark::State& state) {
+    RngStream rng(1, 0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rng.normal());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RngStream_normal);
+
+static void BM_RngStream_normal_float(benchmark::State& state) {
+    RngStream rng(1, 0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rng.normal_float());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RngStream_normal_float);
+
+static void BM_RngStream_construct(benchmark::State& state) {
+    std::uint64_t stream = 0;
+    for (auto _ : state) {
+        RngStream rng(1, stream++);
+        benchmark::DoNotOptimize(rng.next_u64());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RngStream_construct);
+
+// ---------------------------------------------------------------------------
+// Path simulation
+
+static void BM_simulate_path(benchmark::State& state) {
+    GBMParams p = {kS0, kSigma, kT, static_cast<int>(state.range(0))};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(simulate_path(p, kR));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_simulate_path)->Arg(1)->Arg(52)->Arg(252)->ArgName("steps");
+
+static void BM_simulate_path_seeded(benchmark::State& state) {
+    GBMParams p = {kS0, kSigma, kT, static_cast<int>(state.range(0))};
+    std::uint64_t path = 0;
+    for (auto _ : state) {
+        RngStream rng(7, path++);
+        benchmark::DoNotOptimize(simulate_path(p, kR, rng));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_simulate_path_seeded)->Arg(1)->Arg(52)->Arg(252)->ArgName("steps");
+
+// ---------------------------------------------------------------------------
+// Monte Carlo engines
+
+static void BM_monte_carlo_price(benchmark::State& state) {
+    GBMParams p = engine_params(state);
+    ThreadScope threads(static_cast<int>(state.range(2)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(monte_carlo_price(p, kK, true, state.range(0), kR));
+    }
+    set_engine_counters(state);
+}
+BENCHMARK(BM_monte_carlo_price)->Apply(engine_args);
+
+static void BM_monte_carlo_price_seeded(benchmark::State& state) {
+    GBMParams p = engine_params(state);
+    ThreadScope threads(static_cast<int>(state.range(2)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(monte_carlo_price(p, kK, true, state.range(0), kR, 42));
+    }
+    set_engine_counters(state);
+}
+BENCHMARK(BM_monte_carlo_price_seeded)->Apply(engine_args);
+
+static void BM_pricing_plan_run(benchmark::State& state) {
+    GBMParams p = engine_params(state);
+    ThreadScope threads(static_cast<int>(state.range(2)));
+    PricingPlan plan(p, kR, PayoffSpec{kK, true}, EngineOptions{state.range(0), 42});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(plan.run());
+    }
+    set_engine_counters(state);
+}
+BENCHMARK(BM_pricing_plan_run)->Apply(engine_args);
+
+static void BM_pricing_context_run(benchmark::State& state) {
+    GBMParams p = engine_params(state);
+    PricingContext context(static_cast<int>(state.range(2)), 42);
+    PricingPlan plan(p, kR, PayoffSpec{kK, true}, EngineOptions{state.range(0), 42});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(context.run(plan));
+    }
+    set_engine_counters(state);
+}
+BENCHMARK(BM_pricing_context_run)->Apply(engine_args);
+
+template <typename Policy>
+static void BM_monte_carlo_price_policy(benchmark::State& state) {
+    GBMParams p = engine_params(state);
+    ThreadScope threads(static_cast<int>(state.range(2)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(monte_carlo_price_policy<Policy>(
+            p, kK, true, state.range(0), kR, 42));
+    }
+    set_engine_counters(state);
+}
+BENCHMARK_TEMPLATE(BM_monte_carlo_price_policy, DoublePrecision)->Apply(engine_args);
+BENCHMARK_TEMPLATE(BM_monte_carlo_price_policy, MixedPrecision)->Apply(engine_args);
+BENCHMARK_TEMPLATE(BM_monte_carlo_price_policy, CompensatedMixedPrecision)->Apply(engine_args);
+
+// ---------------------------------------------------------------------------
+// Engines built on PricingContext
+
+static void BM_importance_sampling_report(benchmark::State& state) {
+    GBMParams p = engine_params(state);
+    PricingContext context(static_cast<int>(state.range(2)), 42);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            importance_sampling_report(context, p, kR, PayoffSpec{1.3 * kK, true}, state.range(0), 42));
+    }
+    set_engine_counters(state);
+}
+BENCHMARK(BM_importance_sampling_report)->Apply(engine_args);
+
+static void BM_stratified_run(benchmark::State& state) {
+    GBMParams p = engine_params(state);
+    PricingContext context(static_cast<int>(state.range(2)), 42);
+    PricingPlan plan(p, kR, PayoffSpec{kK, true}, EngineOptions{state.range(0), 42});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(stratified_run(context, plan, SamplingOptions{}));
+    }
+    set_engine_counters(state);
+}
+BENCHMARK(BM_stratified_run)->Apply(engine_args);
+
+// Base point only: six scenarios per path
+static void BM_bump_and_revalue(benchmark::State& state) {
+    GBMParams p = engine_params(state);
+    PricingContext context(static_cast<int>(state.range(2)), 42);
+    PricingPlan plan(p, kR, PayoffSpec{kK, true}, EngineOptions{state.range(0), 42});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bump_and_revalue(context, plan, GreeksOptions{}));
+    }
+    set_engine_counters(state);
+}
+BENCHMARK(BM_bump_and_revalue)->Apply(engine_args);
+
+// Cache hit: one payoff pass over the stored growth factors
+static void BM_unit_path_cache_price(benchmark::State& state) {
+    GBMParams p = engine_params(state);
+    PricingContext context(static_cast<int>(state.range(2)), 42);
+    PricingPlan plan(p, kR, PayoffSpec{kK, true}, EngineOptions{state.range(0), 42});
+    UnitPathCache cache;
+    cache.price(context, plan);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cache.price(context, plan));
+    }
+    set_engine_counters(state);
+}
+BENCHMARK(BM_unit_path_cache_price)->Apply(engine_args);
+
+// 3 x 3 x 3 cube of spot, vol and rate shocks
+static void BM_revalue_scenarios(benchmark::State& state) {
+    GBMParams p = engine_params(state);
+    PricingContext context(static_cast<int>(state.range(2)), 42);
+    PricingPlan plan(p, kR, PayoffSpec{kK, true}, EngineOptions{state.range(0), 42});
+    ScenarioGrid grid{{-0.1, 0.0, 0.1}, {-0.05, 0.0, 0.05}, {-0.01, 0.0, 0.01}};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(revalue_scenarios(context, plan, grid));
+    }
+    set_engine_counters(state);
+}
+BENCHMARK(BM_revalue_scenarios)->Apply(engine_args);
+
+// Four maturities by three strikes
+static void BM_price_surface(benchmark::State& state) {
+    GBMParams p = engine_params(state);
+    PricingContext context(static_cast<int>(state.range(2)), 42);
+    std::vector<double> maturities = {0.25, 0.5, 0.75, 1.0};
+    std::vector<PayoffSpec> payoffs = {{90.0, true}, {kK, true}, {110.0, true}};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            price_surface(context, p, kR, maturities, payoffs, EngineOptions{state.range(0), 42}));
+    }
+    set_engine_counters(state);
+}
+BENCHMARK(BM_price_surface)->Apply(engine_args);
+
+static void BM_term_structure_plan_run(benchmark::State& state) {
+    TermStructureModel model{kS0, kT, static_cast<int>(state.range(1)),
+                             TermCurve::linear({0.25, 1.0}, {0.03, kR}),
+                             TermCurve::piecewise_constant({0.5, 1.0}, {0.25, kSigma})};
+    PricingContext context(static_cast<int>(state.range(2)), 42);
+    TermStructurePlan plan(model, PayoffSpec{kK, true}, EngineOptions{state.range(0), 42});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(plan.run(context));
+    }
+    set_engine_counters(state);
+}
+BENCHMARK(BM_term_structure_plan_run)->Apply(engine_args);
+
+// Two slices of 32 nodes with a downward skew
+static void BM_local_vol_plan_run(benchmark::State& state) {
+    const int nodes = 32;
+    std::vector<double> vols;
+    for (int slice = 0; slice < 2; ++slice) {
+        for (int n = 0; n < nodes; ++n) {
+            vols.push_back(0.3 - 0.15 * n / (nodes - 1.0));
+        }
+    }
+    LocalVolSurface surface({0.0, kT}, 20.0, 500.0, nodes, vols);
+    PricingContext context(static_cast<int>(state.range(2)), 42);
+    LocalVolPlan plan(LocalVolModel{kS0, kR, kT, static_cast<int>(state.range(1))}, surface,
+                      PayoffSpec{kK, true}, EngineOptions{state.range(0), 42});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(plan.run(context));
+    }
+    set_engine_counters(state);
+}
+BENCHMARK(BM_local_vol_plan_run)->Apply(engine_args);
+
+// range(0) pilot samples per level from range(1) base steps; the level
+// count is capped so the run time stays bounded
+static void BM_mlmc_price(benchmark::State& state) {
+    GBMParams p = engine_params(state);
+    PricingContext context(static_cast<int>(state.range(2)), 42);
+    MLMCOptions options{0.05, 42};
+    options.base_steps = static_cast<int>(state.range(1));
+    options.max_levels = 4;
+    options.pilot_paths = state.range(0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(mlmc_price(context, p, kR, PayoffSpec{kK, true}, MLMCProduct::European, options));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_mlmc_price)->Apply(engine_args);
+
+// ---------------------------------------------------------------------------
+// Reduction of leaf sums: the canonical tree against a plain in-order merge
+
+std::vector<PathStats> leaf_sums(std::int64_t n_leaves) {
+    RngStream rng(7, 0);
+    std::vector<PathStats> leaves(static_cast<std::size_t>(n_leaves));
+    for (PathStats& leaf : leaves) {
+        leaf.count = kReductionLeafPaths;
+        leaf.samples = kReductionLeafPaths;
+        leaf.sum = rng.uniform();
+        leaf.sum_sq = rng.uniform();
+    }
+    return leaves;
+}
+
+static void BM_reduction_tree(benchmark::State& state) {
+    std::vector<PathStats> leaves = leaf_sums(state.range(0));
+    for (auto _ : state) {
+        ReductionTree tree;
+        for (std::size_t i = 0; i < leaves.size(); ++i) {
+            tree.add_leaf(static_cast<std::int64_t>(i), leaves[i]);
+        }
+        benchmark::DoNotOptimize(tree.total());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_reduction_tree)->Arg(1 << 10)->Arg(1 << 16);
+
+static void BM_reduction_sequential(benchmark::State& state) {
+    std::vector<PathStats> leaves = leaf_sums(state.range(0));
+    for (auto _ : state) {
+        PathStats total;
+        for (const PathStats& leaf : leaves) {
+            total.merge(leaf);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_reduction_sequential)->Arg(1 << 10)->Arg(1 << 16);
+
+// ---------------------------------------------------------------------------
+// Closed form and caching
+
+static void BM_bs_call(benchmark::State& state) {
+    double K = 90.0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bs_call(kS0, K, kR, kSigma, kT));
+        K = K < 110.0 ? K + 0.01 : 90.0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_bs_call);
+
+static void BM_bs_put(benchmark::State& state) {
+    double K = 90.0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bs_put(kS0, K, kR, kSigma, kT));
+        K = K < 110.0 ? K + 0.01 : 90.0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_bs_put);
+
+// Crank-Nicolson with range(0) spot intervals and half as many time steps
+static void BM_pde_price(benchmark::State& state) {
+    PDEOptions options;
+    options.space_nodes = static_cast<int>(state.range(0));
+    options.time_steps = options.space_nodes / 2;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pde_price(kS0, kR, kSigma, kT, PayoffSpec{100.0, true}, options));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_pde_price)->Arg(100)->Arg(400)->ArgName("nodes");
+
+static void BM_cache_hit(benchmark::State& state) {
+    ResultCache cache(1024);
+    GBMParams p = {kS0, kSigma, kT, 12};
+    cache.price_monte_carlo(p, kK, true, 1000, kR, 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cache.price_monte_carlo(p, kK, true, 1000, kR, 1));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_cache_hit);
+
+static void BM_pricing_key_hash(benchmark::State& state) {
+    GBMParams p = {kS0, kSigma, kT, 252};
+    PricingKey key = PricingKey::monte_carlo(p, kK, true, 1000000, kR, 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(key.hash());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_pricing_key_hash);
+
+// ---------------------------------------------------------------------------
+// Path store
+
+static void BM_write_path_store(benchmark::State& state) {
+    std::string file = (std::filesystem::temp_directory_path() / "mc_bench_write.bin").string();
+    GBMParams p = {kS0, kSigma, kT, static_cast<int>(state.range(1))};
+    PathPrecision precision = state.range(2) == 32 ? PathPrecision::Float32 : PathPrecision::Float64;
+    for (auto _ : state) {
+        write_path_store(file, p, kR, state.range(0), 42, precision);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    std::remove(file.c_str());
+}
+BENCHMARK(BM_write_path_store)
+    ->ArgsProduct({{1 << 14}, {52}, {32, 64}})
+    ->ArgNames({"paths", "steps", "bits"})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_price_from_store(benchmark::State& state) {
+    std::string file = (std::filesystem::temp_directory_path() / "mc_bench_read.bin").string();
+    GBMParams p = {kS0, kSigma, kT, 52};
+    PathPrecision precision = state.range(1) == 32 ? PathPrecision::Float32 : PathPrecision::Float64;
+    write_path_store(file, p, kR, state.range(0), 42, precision);
+    {
+        PathStoreReader store(file);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(price_from_store(store, kK, true));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    std::remove(file.c_str());
+}
+BENCHMARK(BM_price_from_store)
+    ->ArgsProduct({{1 << 16}, {32, 64}})
+    ->ArgNames({"paths", "bits"})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
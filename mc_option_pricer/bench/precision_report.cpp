@@ -0,0 +1,68 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "mixed_precision.hpp"
+
+// Precision report: compares float64 and mixed float32/float64 simulation
+// against Black-Scholes from the same seed and reports throughput.
+
+int main(int argc, char* argv[]) {
+    GBMParams params = {100.0, 0.2, 1.0, 252};
+    double r = 0.05;
+    std::int64_t n_paths = 1000000;
+    std::uint64_t seed = 42;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-paths" && i + 1 < argc) {
+            n_paths = std::strtoll(argv[++i], nullptr, 10);
+        } else if (arg == "-steps" && i + 1 < argc) {
+            params.steps = std::atoi(argv[++i]);
+        } else if (arg == "-seed" && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [-paths N] [-steps N] [-seed N]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<double> strikes = {80.0, 90.0, 100.0, 110.0, 120.0};
+    std::vector<PrecisionReportRow> rows =
+        precision_accuracy_report(params, r, strikes, n_paths, seed);
+
+    std::cout << "Precision Accuracy Report (" << n_paths << " paths, "
+              << params.steps << " steps)" << std::endl;
+    std::cout << std::left << std::setw(6) << "Type" << std::right
+              << std::setw(8) << "K" << std::setw(12) << "BS"
+              << std::setw(12) << "double" << std::setw(12) << "mixed"
+              << std::setw(12) << "|dbl-BS|/se" << std::setw(12) << "|mix-BS|/se"
+              << std::setw(10) << "speedup" << std::endl;
+
+    double double_total = 0.0;
+    double mixed_total = 0.0;
+    for (const PrecisionReportRow& row : rows) {
+        double_total += row.double_seconds;
+        mixed_total += row.mixed_seconds;
+        std::cout << std::left << std::setw(6) << (row.call ? "call" : "put") << std::right
+                  << std::fixed << std::setprecision(1) << std::setw(8) << row.K
+                  << std::setprecision(6)
+                  << std::setw(12) << row.bs_price
+                  << std::setw(12) << row.double_price
+                  << std::setw(12) << row.mixed_price
+                  << std::setprecision(2)
+                  << std::setw(12) << std::abs(row.double_price - row.bs_price) / row.stderr
+                  << std::setw(12) << std::abs(row.mixed_price - row.bs_price) / row.mixed_stderr
+                  << std::setw(9) << row.double_seconds / row.mixed_seconds << "x" << std::endl;
+    }
+
+    double path_steps = static_cast<double>(n_paths) * params.steps * rows.size();
+    std::cout << std::endl;
+    std::cout << "double: " << std::scientific << std::setprecision(3)
+              << path_steps / double_total << " path-steps/s" << std::endl;
+    std::cout << "mixed:  " << path_steps / mixed_total << " path-steps/s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,273 @@
+#include <iostream>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "pricing_context.hpp"
+
+// Strong/weak scaling harness for the OpenMP Monte Carlo loop.
+//
+// Strong scaling keeps the total path count fixed while threads grow;
+// weak scaling keeps the paths per thread fixed. Every configuration is
+// repeated to give a mean runtime with a 95% confidence interval.
+
+namespace {
+
+struct ScalingConfig {
+    std::vector<int> threads;
+    std::vector<std::int64_t> paths;
+    std::vector<int> steps;
+    int repeats = 5;
+    bool weak = false;
+    std::string csv_file;
+    std::string json_file;
+};
+
+struct ScalingRow {
+    std::string mode;
+    int threads;
+    std::int64_t paths;
+    int steps;
+    int repeats;
+    double mean_seconds;
+    double stddev_seconds;
+    double ci95_seconds;     // Half-width of the 95% confidence interval
+    double paths_per_second;
+    double ns_per_path_step;
+    double efficiency;       // Strong: T1 / (p * Tp); weak: T1 / Tp
+};
+
+void print_usage(const char* program_name) {
+    std::cout << "Usage: " << program_name << " [options]\n";
+    std::cout << "Options:\n";
+    std::cout << "  -threads <list>   Thread counts, e.g. 1,2,4 (default: 1..max threads)\n";
+    std::cout << "  -paths <list>     Path counts (default: 100000,1000000)\n";
+    std::cout << "  -steps <list>     Step counts (default: 1,52,252)\n";
+    std::cout << "  -repeats <value>  Repetitions per configuration (default: 5)\n";
+    std::cout << "  -weak             Weak scaling: paths are per thread\n";
+    std::cout << "  -csv <file>       Write results as CSV\n";
+    std::cout << "  -json <file>      Write results as JSON\n";
+    std::cout << "  -h, --help        Show this help message\n";
+}
+
+// Positive integers no larger than max_value; anything else exits
+std::vector<std::int64_t> parse_list(const char* arg, const char* param_name,
+                                     std::int64_t max_value = INT64_MAX) {
+    std::vector<std::int64_t> values;
+    std::stringstream stream(arg);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        char* end;
+        errno = 0;
+        long long value = std::strtoll(item.c_str(), &end, 10);
+        if (item.empty() || *end != '\0' || value <= 0 || errno == ERANGE || value > max_value) {
+            std::cerr << "Error: Invalid value for " << param_name << ": " << arg << std::endl;
+            exit(1);
+        }
+        values.push_back(static_cast<std::int64_t>(value));
+    }
+    if (values.empty()) {
+        std::cerr << "Error: Invalid value for " << param_name << ": " << arg << std::endl;
+        exit(1);
+    }
+    return values;
+}
+
+std::vector<int> parse_int_list(const char* arg, const char* param_name) {
+    std::vector<std::int64_t> values = parse_list(arg, param_name, INT_MAX);
+    return std::vector<int>(values.begin(), values.end());
+}
+
+// Two-sided 95% Student-t critical value for the given degrees of freedom
+double t_critical_95(int dof) {
+    static const double table[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306,
+                                   2.262, 2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120,
+                                   2.110, 2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064,
+                                   2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+    if (dof <= 0) {
+        return 0.0;
+    }
+    if (dof <= 30) {
+        return table[dof - 1];
+    }
+    return 1.96;
+}
+
+ScalingRow measure(int threads, std::int64_t paths, int steps, int repeats, bool weak) {
+    PricingContext context(threads);
+    GBMParams params = {100.0, 0.2, 1.0, steps};
+    PricingPlan plan(params, 0.05, PayoffSpec{100.0, true}, EngineOptions{paths, 1});
+
+    // Warm up caches, thread pool and page faults before timing
+    PricingPlan warmup(params, 0.05, PayoffSpec{100.0, true},
+                       EngineOptions{std::max<std::int64_t>(paths / 10, 1), 1});
+    context.run(warmup);
+
+    std::vector<double> seconds;
+    for (int i = 0; i < repeats; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        MCResult result = context.run(plan);
+        seconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        if (!std::isfinite(result.price)) {
+            std::cerr << "Error: Non-finite price in scaling run" << std::endl;
+            exit(1);
+        }
+    }
+
+    double mean = 0.0;
+    for (double s : seconds) {
+        mean += s;
+    }
+    mean /= repeats;
+    double variance = 0.0;
+    for (double s : seconds) {
+        variance += (s - mean) * (s - mean);
+    }
+    double stddev = repeats > 1 ? std::sqrt(variance / (repeats - 1)) : 0.0;
+
+    ScalingRow row;
+    row.mode = weak ? "weak" : "strong";
+    row.threads = threads;
+    row.paths = paths;
+    row.steps = steps;
+    row.repeats = repeats;
+    row.mean_seconds = mean;
+    row.stddev_seconds = stddev;
+    row.ci95_seconds = t_critical_95(repeats - 1) * stddev / std::sqrt(static_cast<double>(repeats));
+    row.paths_per_second = static_cast<double>(paths) / mean;
+    row.ns_per_path_step = mean * 1e9 / (static_cast<double>(paths) * steps);
+    row.efficiency = 1.0;
+    return row;
+}
+
+void write_csv(const std::string& filename, const std::vector<ScalingRow>& rows) {
+    std::ofstream out(filename);
+    out << "mode,threads,paths,steps,repeats,mean_s,stddev_s,ci95_s,paths_per_s,ns_per_path_step,efficiency\n";
+    out << std::setprecision(9);
+    for (const ScalingRow& row : rows) {
+        out << row.mode << ',' << row.threads << ',' << row.paths << ',' << row.steps << ','
+            << row.repeats << ',' << row.mean_seconds << ',' << row.stddev_seconds << ','
+            << row.ci95_seconds << ',' << row.paths_per_second << ',' << row.ns_per_path_step << ','
+            << row.efficiency << '\n';
+    }
+}
+
+void write_json(const std::string& filename, const std::vector<ScalingRow>& rows, int max_threads) {
+    std::ofstream out(filename);
+    out << std::setprecision(9);
+    out << "{\n  \"max_threads\": " << max_threads << ",\n  \"results\": [\n";
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        const ScalingRow& row = rows[i];
+        out << "    {\"mode\": \"" << row.mode << "\", \"threads\": " << row.threads
+            << ", \"paths\": " << row.paths << ", \"steps\": " << row.steps
+            << ", \"repeats\": " << row.repeats << ", \"mean_s\": " << row.mean_seconds
+            << ", \"stddev_s\": " << row.stddev_seconds << ", \"ci95_s\": " << row.ci95_seconds
+            << ", \"paths_per_s\": " << row.paths_per_second
+            << ", \"ns_per_path_step\": " << row.ns_per_path_step
+            << ", \"efficiency\": " << row.efficiency << "}"
+            << (i + 1 < rows.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int max_threads = PricingContext().threads();
+
+    ScalingConfig config;
+    config.paths = {100000, 1000000};
+    config.steps = {1, 52, 252};
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            print_usage(argv[0]);
+            return 0;
+        } else if (arg == "-threads" && i + 1 < argc) {
+            config.threads = parse_int_list(argv[++i], "threads");
+        } else if (arg == "-paths" && i + 1 < argc) {
+            config.paths = parse_list(argv[++i], "paths");
+        } else if (arg == "-steps" && i + 1 < argc) {
+            config.steps = parse_int_list(argv[++i], "steps");
+        } else if (arg == "-repeats" && i + 1 < argc) {
+            config.repeats = parse_int_list(argv[++i], "repeats").front();
+        } else if (arg == "-weak") {
+            config.weak = true;
+        } else if (arg == "-csv" && i + 1 < argc) {
+            config.csv_file = argv[++i];
+        } else if (arg == "-json" && i + 1 < argc) {
+            config.json_file = argv[++i];
+        } else {
+            std::cerr << "Error: Unknown argument " << arg << std::endl;
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (config.threads.empty()) {
+        for (int t = 1; t <= max_threads; ++t) {
+            config.threads.push_back(t);
+        }
+    }
+    if (config.weak) {
+        // Weak scaling simulates paths * threads; reject sweeps that overflow it
+        int widest = *std::max_element(config.threads.begin(), config.threads.end());
+        for (std::int64_t paths : config.paths) {
+            if (paths > INT64_MAX / widest) {
+                std::cerr << "Error: " << paths << " paths per thread on " << widest
+                          << " threads overflow the path count" << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    std::cout << (config.weak ? "Weak" : "Strong") << " scaling, " << config.repeats
+              << " repeats, max threads " << max_threads << std::endl;
+    std::cout << std::setw(8) << "threads" << std::setw(10) << "paths" << std::setw(7) << "steps"
+              << std::setw(12) << "mean ms" << std::setw(10) << "ci95 ms"
+              << std::setw(14) << "paths/s" << std::setw(12) << "ns/step" << std::setw(8) << "eff"
+              << std::endl;
+
+    std::vector<ScalingRow> rows;
+    for (std::int64_t paths : config.paths) {
+        for (int steps : config.steps) {
+            double baseline_seconds = 0.0;
+            for (int threads : config.threads) {
+                std::int64_t total_paths = config.weak ? paths * threads : paths;
+                ScalingRow row = measure(threads, total_paths, steps, config.repeats, config.weak);
+
+                // Efficiency is relative to the first thread count of the sweep
+                if (baseline_seconds == 0.0) {
+                    baseline_seconds = config.weak ? row.mean_seconds : row.mean_seconds * threads;
+                }
+                row.efficiency = config.weak ? baseline_seconds / row.mean_seconds
+                                             : baseline_seconds / (threads * row.mean_seconds);
+                rows.push_back(row);
+
+                std::cout << std::setw(8) << row.threads << std::setw(10) << row.paths
+                          << std::setw(7) << row.steps << std::fixed << std::setprecision(2)
+                          << std::setw(12) << row.mean_seconds * 1e3
+                          << std::setw(10) << row.ci95_seconds * 1e3
+                          << std::setprecision(0) << std::setw(14) << row.paths_per_second
+                          << std::setprecision(2) << std::setw(12) << row.ns_per_path_step
+                          << std::setw(8) << row.efficiency << std::endl;
+            }
+        }
+    }
+
+    if (!config.csv_file.empty()) {
+        write_csv(config.csv_file, rows);
+    }
+    if (!config.json_file.empty()) {
+        write_json(config.json_file, rows, max_threads);
+    }
+    return 0;
+}
@@ -60,4 +60,35 @@ double bs_call(double S0, double K, double r, double sigma, double T);
  */
 double bs_put(double S0, double K, double r, double sigma, double T);
 
+/**
+ * @brief Black-Scholes sensitivities of a European option
+ */
+struct BSGreeks {
+    double delta;  // dV/dS
+    double gamma;  // d2V/dS2
+    double vega;   // dV/dsigma
+    double theta;  // dV/dt = -dV/dT, per year
+};
+
+/**
+ * @brief Closed-form Black-Scholes Greeks
+ * 
+ * With phi the standard normal density:
+ * - delta = N(d1) for a call, N(d1) - 1 for a put
+ * - gamma = phi(d1) / (S0*σ*√T)
+ * - vega  = S0*phi(d1)*√T
+ * - theta = -S0*phi(d1)*σ/(2√T) - r*K*e^(-r*T)*N(d2) for a call,
+ *           -S0*phi(d1)*σ/(2√T) + r*K*e^(-r*T)*N(-d2) for a put
+ * 
+ * @param S0 Current stock price
+ * @param K Strike price
+ * @param r Risk-free interest rate
+ * @param sigma Volatility (positive)
+ * @param T Time to maturity (years)
+ * @param call If true, a call option; if false, a put option
+ * @return BSGreeks Delta, gamma, vega and theta
+ * @throws std::invalid_argument if any input is out of range or sigma is zero
+ */
+BSGreeks bs_greeks(double S0, double K, double r, double sigma, double T, bool call);
+
 #endif // BLACK_SCHOLES_HPP
@@ -0,0 +1,216 @@
+#ifndef CHUNKED_RUN_HPP
+#define CHUNKED_RUN_HPP
+
+#include "pricing_context.hpp"
+#include "pricing_plan.hpp"
+#include "reduction_tree.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+/**
+ * @brief Resumable, chunk-by-chunk execution of a pricing plan
+ *
+ * A ChunkedRun walks the paths of a plan in fixed-size chunks of
+ * consecutive path indices. A chunk spans a power-of-two number of
+ * reduction leaves and starts on a multiple of it, so its sum is a node of
+ * the plan's canonical ReductionTree; the chunks go into a ReductionTree
+ * of their own, keyed by chunk index, which rebuilds that tree exactly.
+ * The result is therefore the same bits as PricingPlan::run() and
+ * PricingContext::run(), whichever thread counts the chunks ran on.
+ *
+ * The state is the next path index plus the chunk tree's pending nodes
+ * (at most two per level), so it fits in a small checkpoint file and a
+ * later process can resume from it.
+ *
+ * Checkpoint layout (host byte order):
+ * - magic "MCCK", format version (u32)
+ * - plan fingerprint (u64), chunk_paths (i64)
+ * - next path (i64), node count (i32)
+ * - per node: first chunk (i64), level (i32), PathStats count and
+ *   samples (i64), sum and sum_sq (f64 bit patterns)
+ *
+ * Files are written to a temporary name, flushed to disk and renamed, so
+ * a crash during a write leaves the previous checkpoint intact.
+ */
+
+/** @brief Paths per chunk unless the caller chooses otherwise */
+const std::int64_t kDefaultChunkPaths = 1 << 16;
+
+/**
+ * @brief Snapshot of a run's convergence, emitted between chunks
+ */
+struct ProgressRecord {
+    std::int64_t paths_done;   // Paths merged into the estimate so far
+    std::int64_t n_paths;      // Paths in the whole valuation
+    double price;              // Running estimate
+    double stderr;             // Running standard error
+    double paths_per_second;   // Throughput of this run() call
+    double elapsed_seconds;    // Wall time of this run() call
+    double eta_seconds;        // Estimated time to completion
+};
+
+/**
+ * @brief Receives progress records; runs on the calling thread
+ */
+using ProgressCallback = std::function<void(const ProgressRecord&)>;
+
+/**
+ * @brief Cooperative cancellation flag shared between a run and its owner
+ *
+ * cancel() may be called from any thread; the run observes it at the next
+ * chunk boundary.
+ */
+class CancellationToken {
+public:
+    void cancel() { flag.store(true, std::memory_order_relaxed); }
+    bool cancelled() const { return flag.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> flag{false};
+};
+
+/**
+ * @brief Conditions under which run_until() stops early
+ */
+struct RunLimits {
+    // Wall-clock deadline; the default never expires
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    // Optional cancellation token (not owned)
+    const CancellationToken* cancel = nullptr;
+};
+
+enum class StopReason {
+    Completed,  // All paths simulated
+    Deadline,   // The next chunk would not finish before the deadline
+    Cancelled   // The cancellation token was set
+};
+
+/**
+ * @brief Estimate of a possibly truncated run
+ *
+ * The estimate covers exactly paths [0, paths_completed) of the plan, so
+ * its stderr is the honest one for that sample size. With no completed
+ * path, price and stderr are NaN.
+ */
+struct BoundedResult {
+    MCResult estimate;
+    std::int64_t paths_completed;
+    StopReason reason;
+};
+
+class ChunkedRun {
+public:
+    /**
+     * @brief Start a run at path 0
+     *
+     * @param plan Validated pricing plan (copied)
+     * @param chunk_paths Paths per chunk
+     * @throws std::invalid_argument unless chunk_paths is a power-of-two
+     *         multiple of plan.leaf_paths()
+     */
+    explicit ChunkedRun(const PricingPlan& plan, std::int64_t chunk_paths = kDefaultChunkPaths);
+
+    /**
+     * @brief Simulate the next chunk and add it to the chunk tree
+     *
+     * @param context Context supplying the threads; it may differ from
+     *        chunk to chunk
+     */
+    void run_chunk(PricingContext& context);
+
+    /**
+     * @brief Run all remaining chunks
+     *
+     * If a checkpoint file is set, it is rewritten whenever the checkpoint
+     * interval has elapsed and once more when the run completes.
+     *
+     * @param context Context supplying the threads
+     * @return MCResult Final estimate
+     * @throws std::runtime_error if a checkpoint cannot be written
+     */
+    MCResult run(PricingContext& context);
+
+    /**
+     * @brief Run remaining chunks until done, past the deadline or cancelled
+     *
+     * Limits are checked between chunks only. Before each chunk the run
+     * predicts its duration from the slowest chunk so far and stops if it
+     * would end after the deadline, so the overshoot is bounded by the
+     * misprediction of a single chunk (and by one full chunk before the
+     * first one has been timed); smaller chunks give a tighter bound. A
+     * stopped run keeps its state: checkpoints are written as in run(),
+     * and calling run() or run_until() again continues it.
+     *
+     * @param context Context supplying the threads
+     * @param limits Deadline and/or cancellation token
+     * @return BoundedResult Estimate, completed paths and stop reason
+     */
+    BoundedResult run_until(PricingContext& context, const RunLimits& limits);
+
+    /**
+     * @brief Estimate from the paths simulated so far
+     * @throws std::logic_error if no path has been simulated yet
+     */
+    MCResult result() const;
+
+    /**
+     * @brief Checkpoint to file every interval_seconds during run()
+     *
+     * @param file Checkpoint path ("" disables checkpointing)
+     * @param interval_seconds Minimum wall time between checkpoints
+     */
+    void set_checkpoint(const std::string& file, double interval_seconds = 60.0);
+
+    /**
+     * @brief Report progress every interval_seconds during run()
+     *
+     * Records are built from the merged chunk totals between chunks, so
+     * the simulation loop itself gains no synchronization. A final record
+     * is always emitted when the run completes.
+     *
+     * @param callback Receiver of the records (empty disables reporting)
+     * @param interval_seconds Minimum wall time between records
+     */
+    void set_progress(ProgressCallback callback, double interval_seconds = 1.0);
+
+    /**
+     * @brief Write the current state to file
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void save_checkpoint(const std::string& file) const;
+
+    /**
+     * @brief Continue from a checkpoint written by an identical run
+     *
+     * @param file Checkpoint path
+     * @return bool false if the file does not exist (the run is unchanged)
+     * @throws std::runtime_error if the file is corrupt or was written for
+     *         a different plan or chunk size
+     */
+    bool resume(const std::string& file);
+
+    bool done() const { return position >= plan.options().n_paths; }
+    std::int64_t next_path() const { return position; }
+    std::int64_t chunk_paths() const { return chunk; }
+    PathStats stats() const { return chunks.total(); }
+    const PricingPlan& pricing_plan() const { return plan; }
+
+private:
+    std::uint64_t fingerprint() const;
+
+    PricingPlan plan;
+    std::int64_t chunk;
+    std::int64_t position = 0;
+    ReductionTree chunks;  // Chunk sums, leaf c = chunk c
+
+    std::string checkpoint_file;
+    double checkpoint_interval = 60.0;
+
+    ProgressCallback progress;
+    double progress_interval = 1.0;
+};
+
+#endif // CHUNKED_RUN_HPP
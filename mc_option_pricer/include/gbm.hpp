@@ -3,6 +3,8 @@
 
 #include <vector>
 
+class RngStream;
+
 /**
  * @brief Geometric Brownian Motion (GBM) parameters
  * 
@@ -34,4 +36,17 @@ struct GBMParams {
  */
 std::vector<double> simulate_path(const GBMParams& p, double r);
 
+/**
+ * @brief Simulate a single GBM path from an explicit random stream
+ * 
+ * Identical to simulate_path(p, r) but draws its normals from the given
+ * stream, so seeded callers get reproducible paths.
+ * 
+ * @param p GBM parameters structure
+ * @param r Risk-free interest rate
+ * @param rng Random stream supplying the normal draws
+ * @return std::vector<double> Simulated prices (length = steps + 1)
+ */
+std::vector<double> simulate_path(const GBMParams& p, double r, RngStream& rng);
+
 #endif // GBM_HPP
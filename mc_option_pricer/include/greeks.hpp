@@ -0,0 +1,84 @@
+#ifndef GREEKS_HPP
+#define GREEKS_HPP
+
+#include "pricing_context.hpp"
+#include "pricing_plan.hpp"
+#include <vector>
+
+/**
+ * @brief Bump-and-revalue Greeks with common random numbers
+ *
+ * Finite differences of two independent Monte Carlo prices have the
+ * variance of both prices, which swamps a small bump. Here every bumped
+ * scenario is revalued on the same paths as the base, so the noise
+ * cancels in the difference and each Greek is estimated from per-path
+ * differences, with its own standard error.
+ *
+ * Each path's terminal driver (PricingPlan::terminal_driver()) is drawn
+ * once and every scenario (spot, vol and maturity bumps at every ladder
+ * point) costs one exp and one payoff (see ScenarioTerminal). With the
+ * plan's drift shift the scenarios share the path's likelihood ratio.
+ *
+ * At each point (S, sigma, T) the Greeks are central differences in spot
+ * and vol and a backward difference in maturity:
+ *
+ *   delta = (V(S(1+h)) - V(S(1-h))) / (2 h S)
+ *   gamma = (V(S(1+h)) - 2 V + V(S(1-h))) / (h S)^2
+ *   vega  = (V(sigma + v) - V(sigma - v)) / (2 v)
+ *   theta = (V(T - tau) - V(T)) / tau   (per year of calendar time)
+ *
+ * All estimates are summed in one reduce_leaves() pass.
+ */
+
+/**
+ * @brief Bump sizes and ladders
+ */
+struct GreeksOptions {
+    double spot_bump = 0.01;              // Relative spot bump h
+    double vol_bump = 0.01;               // Absolute volatility bump v
+    double maturity_bump = 1.0 / 365.0;   // Maturity bump tau (years)
+    std::vector<double> spot_ladder;      // Relative spot shifts to revalue at
+    std::vector<double> vol_ladder;       // Absolute volatility shifts
+    std::vector<double> maturity_ladder;  // Absolute maturity shifts (years)
+};
+
+/**
+ * @brief Price and Greeks at one point, each with its standard error
+ */
+struct GreeksPoint {
+    double S0;       // Spot of the point
+    double sigma;    // Volatility of the point
+    double T;        // Maturity of the point
+    MCResult price;
+    MCResult delta;  // dV/dS
+    MCResult gamma;  // d2V/dS2
+    MCResult vega;   // dV/dsigma
+    MCResult theta;  // dV/dt = -dV/dT
+};
+
+/**
+ * @brief Greeks at the plan's inputs and along each ladder
+ */
+struct GreeksReport {
+    GreeksPoint base;
+    std::vector<GreeksPoint> spot_ladder;      // One point per spot shift, in order
+    std::vector<GreeksPoint> vol_ladder;       // One point per volatility shift
+    std::vector<GreeksPoint> maturity_ladder;  // One point per maturity shift
+};
+
+/**
+ * @brief Revalue a plan under bumped inputs on common random numbers
+ *
+ * @param context Context supplying the threads
+ * @param plan Validated pricing plan (model, payoff, n_paths, seed and
+ *        drift shift are used)
+ * @param options Bump sizes and ladders
+ * @return GreeksReport Price and Greeks at every point
+ * @throws std::invalid_argument if a bump size is not positive, a bumped
+ *         spot, volatility or maturity leaves its domain, the plan uses
+ *         a batch correction, or the ladders need more than
+ *         kMaxReductionSums revaluations
+ */
+GreeksReport bump_and_revalue(PricingContext& context, const PricingPlan& plan, const GreeksOptions& options);
+
+#endif // GREEKS_HPP
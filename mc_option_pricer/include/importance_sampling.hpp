@@ -0,0 +1,73 @@
+#ifndef IMPORTANCE_SAMPLING_HPP
+#define IMPORTANCE_SAMPLING_HPP
+
+#include "pricing_context.hpp"
+#include "pricing_plan.hpp"
+#include <cstdint>
+
+/**
+ * @brief Importance sampling for options far from the money
+ *
+ * For a strike far from S0 almost every plain path pays zero, and the
+ * relative standard error grows without bound as the option moves out of
+ * the money. Shifting the Brownian driver towards the exercise region
+ * (EngineOptions::drift_shift) makes most paths pay; the likelihood ratio
+ * applied in PricingPlan::path_payoff() keeps the estimate unbiased.
+ *
+ * The shift is chosen by the saddle-point (optimal drift) rule of
+ * Glasserman, Heidelberger and Shahabuddin: a European payoff depends on
+ * the paths only through the terminal normal z, and the zero-variance
+ * density is proportional to payoff(z) * phi(z), so the normal is centered
+ * on the mode of that density:
+ *
+ *   a = argmax_z [ log payoff(z) - z^2 / 2 ]
+ */
+
+/**
+ * @brief Saddle-point drift shift for a European payoff
+ *
+ * Solves s S(z) / (S(z) - K) = z for a call and -s S(z) / (K - S(z)) = z
+ * for a put, with S(z) = S0 exp((r - sigma^2/2) T + s z) and s = sigma
+ * sqrt(T). The left side is decreasing in z on the exercise region, so
+ * the root is unique and is found by bisection.
+ *
+ * @param p GBM parameters (S0, sigma, T)
+ * @param r Risk-free interest rate
+ * @param payoff Strike and option type
+ * @return double Shift of the terminal normal (0 when sigma is 0)
+ */
+double optimal_drift_shift(const GBMParams& p, double r, const PayoffSpec& payoff);
+
+/**
+ * @brief Importance-sampled estimate next to a plain one
+ */
+struct ImportanceSamplingReport {
+    double shift;               // Drift shift used, in standard deviations
+    MCResult shifted;           // Importance-sampled estimate
+    MCResult plain;             // Plain estimate with the same path count and seed
+    double variance_reduction;  // (plain stderr / shifted stderr)^2, infinite
+                                // if no plain path paid, NaN if the shifted
+                                // estimate has no sampling error
+};
+
+/**
+ * @brief Price with the optimal shift and measure the gain over plain MC
+ *
+ * Runs the importance-sampled plan and a plain plan with the same number
+ * of paths. The variance reduction is the factor by which plain Monte
+ * Carlo would need more paths for the same standard error.
+ *
+ * @param context Context supplying the threads
+ * @param p GBM parameters
+ * @param r Risk-free interest rate
+ * @param payoff Strike and option type
+ * @param n_paths Paths of each run
+ * @param seed Seed of both runs
+ * @return ImportanceSamplingReport Both estimates and the variance reduction
+ * @throws std::invalid_argument if any input is out of range
+ */
+ImportanceSamplingReport importance_sampling_report(PricingContext& context, const GBMParams& p,
+                                                    double r, const PayoffSpec& payoff,
+                                                    std::int64_t n_paths, std::uint64_t seed);
+
+#endif // IMPORTANCE_SAMPLING_HPP
@@ -0,0 +1,172 @@
+#ifndef LOCAL_VOL_HPP
+#define LOCAL_VOL_HPP
+
+#include "pricing_context.hpp"
+#include "pricing_plan.hpp"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Dupire local-volatility pricing
+ *
+ * Under local volatility the spot follows
+ *
+ *   dS / S = r dt + sigma(t, S) dW,
+ *
+ * with sigma(t, S) chosen so that the model reprices a whole implied
+ * volatility surface. dupire_local_vol() builds sigma on a grid from the
+ * implied surface with Dupire's formula in total implied variance
+ * w(T, y) = sigma_imp^2 T, y = log(K / F(T)) (Gatheral's form):
+ *
+ *   sigma^2 = w_T / (1 - y w_y / w + (-1/4 - 1/w + y^2 / w^2) w_y^2 / 4 + w_yy / 2),
+ *
+ * evaluated at K = S, T = t.
+ *
+ * The surface stores one contiguous slice per time over nodes uniform in
+ * log S, so locating a spot is one multiply, with no search. A
+ * LocalVolPlan resamples the surface onto its own step times once, so
+ * the path loop reads one slice per step and interpolates linearly in
+ * log S; the bilinear interpolation of the surface reduces to that
+ * because the step times are exact slices. Paths advance in blocks of
+ * kReductionLeafPaths, step by step, so each slice is read from cache for
+ * the whole block and the lookups of a step form one branch-free loop
+ * the compiler can vectorize.
+ */
+
+/**
+ * @brief Implied volatilities on a maturity x strike grid
+ */
+struct ImpliedVolSurface {
+    std::vector<double> maturities;  // Strictly increasing, positive
+    std::vector<double> strikes;     // Strictly increasing, positive
+    std::vector<double> vols;        // Maturity-major: vols[i * strikes.size() + j]
+};
+
+/**
+ * @brief Local volatility sigma(t, S) on a time x log-spot grid
+ *
+ * Values are interpolated bilinearly in (t, log S) and held flat outside
+ * the grid.
+ */
+class LocalVolSurface {
+public:
+    /**
+     * @brief Build a surface from its slices
+     *
+     * @param times Slice times, strictly increasing and non-negative
+     * @param spot_min Spot of the first node
+     * @param spot_max Spot of the last node
+     * @param spot_nodes Nodes per slice, uniform in log S (at least 2)
+     * @param vols Slice-major values: vols[i * spot_nodes + n]
+     * @throws std::invalid_argument if the grid is malformed or a value is
+     *         negative or not finite
+     */
+    LocalVolSurface(std::vector<double> times, double spot_min, double spot_max, int spot_nodes,
+                    std::vector<double> vols);
+
+    /** @brief Local volatility at time t and spot S */
+    double value(double t, double S) const;
+
+    const std::vector<double>& times() const { return slice_times; }
+    double log_spot_min() const { return x_min; }
+    double log_spot_step() const { return dx; }
+    int spot_nodes() const { return nodes; }
+
+    /** @brief The spot_nodes values of slice i */
+    const double* slice(std::size_t i) const { return &values[i * static_cast<std::size_t>(nodes)]; }
+
+private:
+    std::vector<double> slice_times;
+    double x_min;  // log S of the first node
+    double dx;     // Log-spot spacing of the nodes
+    int nodes;
+    std::vector<double> values;
+};
+
+/** @brief Floor of the local variance of arbitrageable implied surfaces */
+const double kMinLocalVariance = 1e-8;
+
+/**
+ * @brief Local volatility from an implied surface by Dupire's formula
+ *
+ * Implied volatilities are interpolated with a natural cubic spline in
+ * log-moneyness per maturity and linearly in total variance across
+ * maturities (constant volatility before the first maturity and after
+ * the last); derivatives are central differences of that interpolant.
+ * Where the implied surface admits arbitrage the local variance comes out
+ * non-positive; it is floored at kMinLocalVariance.
+ *
+ * @param implied Implied volatility grid
+ * @param S0 Spot
+ * @param r Risk-free rate
+ * @param times Slice times of the result
+ * @param spot_min Spot of the first node of the result
+ * @param spot_max Spot of the last node of the result
+ * @param spot_nodes Nodes per slice of the result
+ * @return LocalVolSurface Local volatility on the requested grid
+ * @throws std::invalid_argument if the implied grid or the requested grid
+ *         is malformed
+ */
+LocalVolSurface dupire_local_vol(const ImpliedVolSurface& implied, double S0, double r,
+                                 const std::vector<double>& times, double spot_min, double spot_max, int spot_nodes);
+
+/**
+ * @brief Local-volatility model inputs
+ */
+struct LocalVolModel {
+    double S0;  // Initial stock price
+    double r;   // Risk-free rate
+    double T;   // Time to maturity (years)
+    int steps;  // Number of uniform time steps
+};
+
+/**
+ * @brief Compiled Monte Carlo valuation under local volatility
+ *
+ * Like PricingPlan, construction validates the inputs and compiles the
+ * per-step slices; run() can be executed any number of times and throws
+ * nothing but std::bad_alloc from its scratch and reduction buffers. Each
+ * step is a log-Euler step with the volatility of the step's start:
+ *
+ *   log S += (r - sigma^2 / 2) dt + sigma sqrt(dt) Z,  sigma = sigma(t_j, S_j).
+ *
+ * Path i draws the same normals, in step order, as the PricingPlan of the
+ * same inputs.
+ */
+class LocalVolPlan {
+public:
+    /**
+     * @brief Validate the inputs and compile the per-step slices
+     *
+     * @param model Spot, rate, maturity and grid
+     * @param surface Local volatility surface
+     * @param payoff Strike and option type
+     * @param options Paths and seed (no drift shift or batch corrections)
+     * @throws std::invalid_argument if an input is out of range or the
+     *         engine shifts the drift or uses a batch correction
+     */
+    LocalVolPlan(const LocalVolModel& model, const LocalVolSurface& surface, const PayoffSpec& payoff,
+                 const EngineOptions& options);
+
+    /**
+     * @brief Run the valuation
+     *
+     * @param context Context supplying the threads
+     * @return MCResult Price estimate and standard error
+     */
+    MCResult run(PricingContext& context) const;
+
+private:
+    LocalVolModel model;
+    PayoffSpec spec;
+    EngineOptions engine;
+    double x_min;                 // log S of the first node
+    double inv_dx;                // Nodes per unit of log S
+    int nodes;
+    std::vector<double> slices;   // Step-major: sigma at step j, node n
+    double dt;
+    double sqrt_dt;
+    double discount;
+};
+
+#endif // LOCAL_VOL_HPP
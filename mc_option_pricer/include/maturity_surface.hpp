@@ -0,0 +1,61 @@
+#ifndef MATURITY_SURFACE_HPP
+#define MATURITY_SURFACE_HPP
+
+#include "pricing_context.hpp"
+#include "pricing_plan.hpp"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Strike x maturity surface from one simulation
+ *
+ * A path stepped to the longest maturity passes through every shorter
+ * one, so options at 3M, 6M and 1Y need one path set rather than three.
+ * price_surface() steps each path once, records log S at every
+ * observation time and evaluates every payoff there.
+ *
+ * The simulation grid is the uniform grid of params.steps steps over
+ * params.T, with each observation time that falls between two grid points
+ * inserted as an extra point. The log-space scheme is exact on any grid,
+ * so every maturity is priced without discretization bias. Stepping stops
+ * at the last observation time.
+ *
+ * Path i draws one normal per interval of the grid. When params.T is
+ * observed and no time is inserted before it, its column equals
+ * PricingContext::run() of the plan at params.T.
+ */
+
+/**
+ * @brief Prices of every (maturity, payoff) point with their standard errors
+ *
+ * prices is indexed by maturity, then payoff; use at().
+ */
+struct MaturitySurface {
+    std::vector<double> maturities;   // Observation times, as given
+    std::vector<PayoffSpec> payoffs;  // Strikes and option types, as given
+    std::vector<MCResult> prices;
+
+    const MCResult& at(std::size_t maturity, std::size_t payoff) const {
+        return prices[maturity * payoffs.size() + payoff];
+    }
+};
+
+/**
+ * @brief Price a strike x maturity surface on one path set
+ *
+ * @param context Context supplying the threads
+ * @param params Model; T and steps set the simulation grid
+ * @param r Risk-free rate
+ * @param maturities Observation times in (0, params.T], in any order
+ * @param payoffs Strikes and option types priced at every maturity
+ * @param engine Paths and seed (no drift shift or batch corrections)
+ * @return MaturitySurface Price and standard error of every point
+ * @throws std::invalid_argument if a parameter is out of range, a
+ *         maturity lies outside (0, params.T], either list is empty, or the
+ *         engine shifts the drift or uses a batch correction
+ */
+MaturitySurface price_surface(PricingContext& context, const GBMParams& params, double r,
+                              const std::vector<double>& maturities, const std::vector<PayoffSpec>& payoffs,
+                              const EngineOptions& engine);
+
+#endif // MATURITY_SURFACE_HPP
@@ -0,0 +1,127 @@
+#ifndef MCPRICER_H
+#define MCPRICER_H
+
+/*
+ * C ABI of libmcpricer
+ *
+ * A stable, exception-free entry point to the Monte Carlo engine for
+ * in-process callers (Python ctypes/cffi, Java FFM/JNA, ...). All state
+ * lives behind an opaque mcp_context handle; every call reports failure
+ * through an mcp_status code, and the message of the most recent failure
+ * on a context is available from mcp_context_last_error().
+ *
+ * Batch calls take structure-of-arrays inputs owned by the caller: element
+ * i of every input array describes option i, and results are written to
+ * caller-allocated output arrays of the same length. The library never
+ * retains or frees caller memory.
+ *
+ * A context is not thread-safe; use one context per calling thread.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * The library is compiled with hidden visibility; MCPRICER_API marks the
+ * entry points it exports. MCPRICER_BUILDING is defined only while the
+ * library itself is compiled.
+ */
+#if defined(_WIN32)
+#if defined(MCPRICER_BUILDING)
+#define MCPRICER_API __declspec(dllexport)
+#else
+#define MCPRICER_API __declspec(dllimport)
+#endif
+#else
+#define MCPRICER_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Incremented whenever a signature or struct layout in this header changes */
+#define MCPRICER_ABI_VERSION 1
+
+typedef enum mcp_status {
+    MCP_OK = 0,
+    MCP_INVALID_ARGUMENT = 1, /* An input is out of range */
+    MCP_NULL_POINTER = 2,     /* A required pointer argument is NULL */
+    MCP_OUT_OF_MEMORY = 3,
+    MCP_INTERNAL_ERROR = 4
+} mcp_status;
+
+typedef struct mcp_context mcp_context;
+
+/* ABI version the library was built with; compare to MCPRICER_ABI_VERSION */
+MCPRICER_API uint32_t mcp_abi_version(void);
+
+/* Static description of a status code (never NULL) */
+MCPRICER_API const char* mcp_status_string(mcp_status status);
+
+/*
+ * Create a context.
+ *
+ * threads: worker threads per pricing run, 0 for the OpenMP default
+ * seed:    seed of the context's seed sequence, used by batch calls that
+ *          pass no explicit seeds
+ * out:     receives the new handle; release it with mcp_context_destroy()
+ */
+MCPRICER_API mcp_status mcp_context_create(int32_t threads, uint64_t seed, mcp_context** out);
+
+/* Destroy a context; NULL is ignored */
+MCPRICER_API void mcp_context_destroy(mcp_context* context);
+
+/* Thread budget of the context, or 0 for a NULL handle */
+MCPRICER_API int32_t mcp_context_threads(const mcp_context* context);
+
+/* Message of the last failed call on the context ("" if none, never NULL) */
+MCPRICER_API const char* mcp_context_last_error(const mcp_context* context);
+
+/*
+ * Price one European option by Monte Carlo.
+ *
+ * is_call is nonzero for a call and zero for a put. Paths are generated
+ * from the given seed, so equal inputs give equal results.
+ */
+MCPRICER_API mcp_status mcp_price_european(mcp_context* context, double S0, double K, double r,
+                                           double sigma, double T, int32_t steps, int64_t n_paths,
+                                           int32_t is_call, uint64_t seed, double* price,
+                                           double* std_error);
+
+/*
+ * Price n European options by Monte Carlo.
+ *
+ * Inputs S0, K, r, sigma, T, steps, n_paths and is_call are arrays of
+ * length n. seeds may be NULL, in which case each option draws its seed
+ * from the context's seed sequence. price and std_error receive the
+ * results; std_error may be NULL. status may be NULL, otherwise it
+ * receives the per-option status.
+ *
+ * Invalid options do not stop the batch: their price and std_error are
+ * set to NaN and the call returns the status of the first failure.
+ */
+MCPRICER_API mcp_status mcp_price_european_batch(mcp_context* context, size_t n, const double* S0,
+                                                 const double* K, const double* r,
+                                                 const double* sigma, const double* T,
+                                                 const int32_t* steps, const int64_t* n_paths,
+                                                 const int32_t* is_call, const uint64_t* seeds,
+                                                 double* price, double* std_error,
+                                                 int32_t* status);
+
+/*
+ * Black-Scholes prices of n European options.
+ *
+ * Same array conventions as mcp_price_european_batch(); no context is
+ * needed because the closed form has no state.
+ */
+MCPRICER_API mcp_status mcp_black_scholes_batch(size_t n, const double* S0, const double* K,
+                                                const double* r, const double* sigma,
+                                                const double* T, const int32_t* is_call,
+                                                double* price, int32_t* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MCPRICER_H */
@@ -0,0 +1,116 @@
+#ifndef MIXED_PRECISION_HPP
+#define MIXED_PRECISION_HPP
+
+#include "gbm.hpp"
+#include "pricer.hpp"
+#include "random_utils.hpp"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Precision policies for Monte Carlo simulation
+ *
+ * A policy chooses the floating-point type used to evolve paths and the
+ * accumulator used to sum discounted payoffs. Paths are evolved in log
+ * space, x_{t+1} = x_t + (r - 0.5*sigma^2)*dt + sigma*sqrt(dt)*Z, which
+ * keeps the per-step magnitude small enough for float32 and removes the
+ * per-step exp() of simulate_path(). float32 policies also draw their
+ * normals with RngStream::normal_float(), which is where most of the
+ * saving comes from: normal generation dominates the per-step cost.
+ */
+
+/**
+ * @brief float64 paths, float64 accumulation (reference policy)
+ */
+struct DoublePrecision {
+    using path_type = double;
+    static constexpr bool compensated = false;
+    static const char* name() { return "double"; }
+    static path_type normal(RngStream& rng) { return rng.normal(); }
+};
+
+/**
+ * @brief float32 paths, float64 accumulation
+ */
+struct MixedPrecision {
+    using path_type = float;
+    static constexpr bool compensated = false;
+    static const char* name() { return "mixed"; }
+    static path_type normal(RngStream& rng) { return rng.normal_float(); }
+};
+
+/**
+ * @brief float32 paths, compensated (Neumaier) float64 accumulation
+ */
+struct CompensatedMixedPrecision {
+    using path_type = float;
+    static constexpr bool compensated = true;
+    static const char* name() { return "mixed-compensated"; }
+    static path_type normal(RngStream& rng) { return rng.normal_float(); }
+};
+
+/**
+ * @brief Price a European option with a given precision policy
+ *
+ * Path i draws its normals from RngStream(seed, i) through the policy's
+ * normal(); for DoublePrecision these are exactly the draws of the
+ * seeded monte_carlo_price overload. The payoff is always evaluated and
+ * accumulated in float64; per-thread sums are merged in thread order and
+ * the standard error comes from estimate_price(), as for the reference
+ * engines.
+ *
+ * Instantiated for DoublePrecision, MixedPrecision and
+ * CompensatedMixedPrecision.
+ *
+ * @param p GBM parameters (S0, sigma, T, steps)
+ * @param K Strike price
+ * @param call If true, price a call option; if false, price a put option
+ * @param n_paths Number of Monte Carlo simulation paths
+ * @param r Risk-free interest rate
+ * @param seed Seed identifying the random streams
+ * @return MCResult Price estimate and standard error
+ */
+template <typename Policy>
+MCResult monte_carlo_price_policy(const GBMParams& p, double K, bool call, std::int64_t n_paths,
+                                  double r, std::uint64_t seed);
+
+extern template MCResult monte_carlo_price_policy<DoublePrecision>(
+    const GBMParams&, double, bool, std::int64_t, double, std::uint64_t);
+extern template MCResult monte_carlo_price_policy<MixedPrecision>(
+    const GBMParams&, double, bool, std::int64_t, double, std::uint64_t);
+extern template MCResult monte_carlo_price_policy<CompensatedMixedPrecision>(
+    const GBMParams&, double, bool, std::int64_t, double, std::uint64_t);
+
+/**
+ * @brief One row of a precision accuracy report
+ */
+struct PrecisionReportRow {
+    double K;
+    bool call;
+    double bs_price;        // Black-Scholes reference
+    double double_price;    // DoublePrecision estimate
+    double mixed_price;     // MixedPrecision estimate
+    double stderr;          // Standard error of the double estimate
+    double mixed_stderr;    // Standard error of the mixed estimate
+    double double_seconds;  // Runtime of the double run
+    double mixed_seconds;   // Runtime of the mixed run
+};
+
+/**
+ * @brief Compare the double and mixed policies against Black-Scholes
+ *
+ * Prices a call and a put for every strike with both policies from the
+ * same seed and records prices, standard errors and runtimes.
+ *
+ * @param p GBM parameters
+ * @param r Risk-free interest rate
+ * @param strikes Strikes to price
+ * @param n_paths Paths per valuation
+ * @param seed Seed identifying the random streams
+ * @return std::vector<PrecisionReportRow> One row per (strike, call/put)
+ */
+std::vector<PrecisionReportRow> precision_accuracy_report(const GBMParams& p, double r,
+                                                          const std::vector<double>& strikes,
+                                                          std::int64_t n_paths, std::uint64_t seed);
+
+#endif // MIXED_PRECISION_HPP
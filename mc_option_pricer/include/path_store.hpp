@@ -0,0 +1,161 @@
+#ifndef PATH_STORE_HPP
+#define PATH_STORE_HPP
+
+#include "gbm.hpp"
+#include "pricer.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Memory-mapped store of simulated GBM paths
+ *
+ * Path generation dominates the cost of pricing, yet every payoff on the
+ * same model consumes the same paths. This module writes seeded paths
+ * once to a file and maps it read-only into any number of pricing
+ * processes, which then evaluate payoffs directly on the mapped pages.
+ *
+ * File layout (all fields native-endian):
+ * - PathStoreHeader, padded to kPathStoreDataOffset bytes
+ * - ceil(n_paths / chunk_paths) chunks, each holding (steps + 1) rows of
+ *   chunk_paths values (structure of arrays: row s is the price of every
+ *   path of the chunk at step s). The last chunk is zero padded.
+ */
+
+/**
+ * @brief Storage precision of path values
+ */
+enum class PathPrecision : std::uint32_t {
+    Float32 = 1,
+    Float64 = 2
+};
+
+/**
+ * @brief Random generator that produced the stored paths
+ */
+enum class PathGenerator : std::uint32_t {
+    Xoshiro256StarStarPolar = 1  // RngStream(seed, path index)
+};
+
+/**
+ * @brief Fixed-size header at the start of every path store file
+ */
+struct PathStoreHeader {
+    char magic[8];              // "MCPATHS\0"
+    std::uint32_t version;
+    std::uint32_t precision;    // PathPrecision
+    std::uint32_t generator;    // PathGenerator
+    std::uint32_t steps;
+    std::uint64_t n_paths;
+    std::uint64_t chunk_paths;  // Paths per chunk (row width)
+    std::uint64_t seed;
+    double S0;
+    double sigma;
+    double T;
+    double r;
+};
+
+/**
+ * @brief Byte offset of the first chunk (page aligned)
+ */
+const std::size_t kPathStoreDataOffset = 4096;
+
+/**
+ * @brief Simulate seeded paths and write them to a path store file
+ *
+ * Path i is generated from RngStream(seed, i) exactly as the seeded
+ * monte_carlo_price overload does, so pricing from the store reproduces
+ * the seeded pricer (up to the storage precision). Chunks are filled in
+ * parallel directly in the mapping of a uniquely named temporary file in
+ * the target's directory, which is flushed and then renamed over the
+ * target, so processes that have an older store mapped are unaffected.
+ *
+ * @param filename Output file (overwritten)
+ * @param p GBM parameters
+ * @param r Risk-free interest rate
+ * @param n_paths Number of paths to store
+ * @param seed Seed identifying the random streams
+ * @param precision Storage precision of the path values
+ * @param chunk_paths Paths per chunk
+ * @throws std::invalid_argument on invalid parameters
+ * @throws std::runtime_error if the file cannot be created or mapped
+ */
+void write_path_store(const std::string& filename, const GBMParams& p, double r,
+                      std::int64_t n_paths, std::uint64_t seed,
+                      PathPrecision precision = PathPrecision::Float64,
+                      std::int64_t chunk_paths = 4096);
+
+/**
+ * @brief Read-only memory mapping of a path store file
+ *
+ * Chunk rows are returned as pointers into the mapping; nothing is
+ * copied. Several processes can map the same file concurrently and
+ * share the page cache.
+ */
+class PathStoreReader {
+public:
+    /**
+     * @brief Map a path store file
+     *
+     * @throws std::runtime_error if the file is missing, truncated or not a path store
+     */
+    explicit PathStoreReader(const std::string& filename);
+    ~PathStoreReader();
+
+    PathStoreReader(const PathStoreReader&) = delete;
+    PathStoreReader& operator=(const PathStoreReader&) = delete;
+
+    const PathStoreHeader& header() const { return *info; }
+
+    /**
+     * @brief GBM parameters the paths were simulated with
+     */
+    GBMParams params() const;
+
+    PathPrecision precision() const { return static_cast<PathPrecision>(info->precision); }
+    std::int64_t n_paths() const { return static_cast<std::int64_t>(info->n_paths); }
+    std::int64_t n_chunks() const;
+
+    /**
+     * @brief Number of valid paths in a chunk (the last one may be partial)
+     */
+    std::int64_t chunk_size(std::int64_t chunk) const;
+
+    /**
+     * @brief Row of path values at one step of one chunk
+     *
+     * T must match the stored precision (float for Float32, double for
+     * Float64).
+     *
+     * @param chunk Chunk index
+     * @param step Step index in [0, steps]
+     * @return const T* chunk_size(chunk) contiguous values
+     * @throws std::logic_error if T does not match the stored precision
+     */
+    template <typename T>
+    const T* row(std::int64_t chunk, int step) const;
+
+private:
+    const unsigned char* chunk_base(std::int64_t chunk) const;
+
+    void* mapping;
+    std::size_t mapped_size;
+    const PathStoreHeader* info;
+};
+
+/**
+ * @brief Price a European option from stored paths
+ *
+ * Streams the terminal row of every chunk straight from the mapping and
+ * discounts with the r and T recorded in the header. The payoffs are
+ * summed with reduce_leaves(), so the estimate does not depend on the
+ * thread count.
+ *
+ * @param store Mapped path store
+ * @param K Strike price
+ * @param call If true, price a call option; if false, price a put option
+ * @return MCResult Price estimate and standard error
+ */
+MCResult price_from_store(const PathStoreReader& store, double K, bool call);
+
+#endif // PATH_STORE_HPP
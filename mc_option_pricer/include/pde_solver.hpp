@@ -0,0 +1,97 @@
+#ifndef PDE_SOLVER_HPP
+#define PDE_SOLVER_HPP
+
+#include "pricing_plan.hpp"
+#include <limits>
+#include <vector>
+
+/**
+ * @brief Crank-Nicolson finite-difference pricing of the Black-Scholes PDE
+ *
+ * For a single-asset vanilla or barrier option the Black-Scholes PDE
+ *
+ *   V_tau = sigma^2 S^2 V_SS / 2 + r S V_S - r V   (tau = time to maturity)
+ *
+ * can be solved to a given accuracy far faster than Monte Carlo
+ * converges. The solver:
+ *
+ * - puts the spot nodes on a sinh-stretched grid S = K + c sinh(xi),
+ *   xi uniform, so nodes concentrate around the strike where the payoff
+ *   has its kink; the ends are the knock-out barriers when present;
+ * - uses second-order three-point differences on the non-uniform grid
+ *   and Dirichlet boundaries (discounted intrinsic value, or zero at a
+ *   barrier);
+ * - steps with Crank-Nicolson after Rannacher start-up, which replaces the
+ *   first Crank-Nicolson steps by implicit Euler half steps so the kink
+ *   of the payoff does not excite the undamped oscillations of
+ *   Crank-Nicolson;
+ * - solves the tridiagonal systems with the Thomas algorithm, factored
+ *   once per step size.
+ *
+ * pde_price() solves any number of strikes together: each strike has its
+ * own grid, and the systems are stored node-major with the strikes
+ * contiguous, so every sweep of the Thomas algorithm is a loop across
+ * strikes the compiler can vectorize. Each strike's arithmetic is the
+ * same whatever the batch, so batched prices equal single prices.
+ *
+ * Barriers are monitored continuously and knock the option out with no
+ * rebate.
+ */
+
+/**
+ * @brief Grid and time-stepping controls
+ */
+struct PDEOptions {
+    int space_nodes = 400;       // Spot intervals per strike
+    int time_steps = 200;        // Crank-Nicolson steps over T
+    int rannacher_steps = 2;     // Leading steps replaced by two implicit half steps each
+    double concentration = 0.1;  // Stretch scale c as a fraction of the strike
+    double width = 5.0;          // Upper spot bound, in standard deviations of log S above max(S0, K)
+};
+
+/**
+ * @brief Knock-out barriers; the defaults mean none
+ */
+struct BarrierSpec {
+    double lower = 0.0;                                       // Down-and-out level (0: none)
+    double upper = std::numeric_limits<double>::infinity();  // Up-and-out level (infinity: none)
+};
+
+/**
+ * @brief Price and spot sensitivities at S0 from the solved grid
+ */
+struct PDEResult {
+    double price;
+    double delta;  // dV/dS
+    double gamma;  // d2V/dS2
+};
+
+/**
+ * @brief Price several options on one underlying by Crank-Nicolson
+ *
+ * @param S0 Initial stock price
+ * @param r Risk-free rate
+ * @param sigma Volatility
+ * @param T Time to maturity (years)
+ * @param payoffs Strikes and option types, solved as one batch
+ * @param options Grid and time-stepping controls
+ * @param barrier Knock-out barriers shared by all payoffs
+ * @return std::vector<PDEResult> One result per payoff, in order
+ * @throws std::invalid_argument if a parameter is out of range, the grid
+ *         controls are too small, or the barriers do not satisfy
+ *         0 <= lower < upper
+ */
+std::vector<PDEResult> pde_price(double S0, double r, double sigma, double T, const std::vector<PayoffSpec>& payoffs,
+                                 const PDEOptions& options = PDEOptions(),
+                                 const BarrierSpec& barrier = BarrierSpec());
+
+/**
+ * @brief Price one option by Crank-Nicolson
+ *
+ * @return PDEResult Price, delta and gamma at S0
+ * @throws std::invalid_argument as the batched overload
+ */
+PDEResult pde_price(double S0, double r, double sigma, double T, const PayoffSpec& payoff,
+                    const PDEOptions& options = PDEOptions(), const BarrierSpec& barrier = BarrierSpec());
+
+#endif // PDE_SOLVER_HPP
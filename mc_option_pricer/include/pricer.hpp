@@ -2,6 +2,7 @@
 #define PRICER_HPP
 
 #include "gbm.hpp"
+#include <cstdint>
 
 /**
  * @brief Monte Carlo simulation result structure
@@ -28,13 +29,18 @@ struct MCResult {
  * calculates the option price as the discounted expected payoff.
  * 
  * Algorithm:
- * 1. For each simulation path:
- *    - Generate a complete stock price path using simulate_path()
+ * 1. Validate all inputs and fold the per-step constants (PricingPlan)
+ * 2. For each simulation path:
+ *    - Evolve the log price over all time steps
  *    - Calculate the payoff at maturity (call or put)
  *    - Discount the payoff to present value using exp(-r*T)
- * 2. Calculate the mean and variance of all discounted payoffs
- * 3. Return both the price estimate and its standard error
+ * 3. Calculate the mean and variance of all discounted payoffs
+ * 4. Return both the price estimate and its standard error
  * 
+ * Each call draws a fresh random seed, so repeated calls give
+ * independent estimates.
+ * 
+ * @throws std::invalid_argument if any input is out of range
  * @param p GBM parameters (S0, mu, sigma, T, steps)
  * @param K Strike price
  * @param call If true, price a call option; if false, price a put option
@@ -42,6 +48,25 @@ struct MCResult {
  * @param r Risk-free interest rate for discounting
  * @return MCResult Structure containing price estimate and standard error
  */
-MCResult monte_carlo_price(const GBMParams& p, double K, bool call, int n_paths, double r);
+MCResult monte_carlo_price(const GBMParams& p, double K, bool call, std::int64_t n_paths, double r);
+
+/**
+ * @brief Price a European option using seeded Monte Carlo simulation
+ * 
+ * Same algorithm as the unseeded overload, but path i draws its normals
+ * from RngStream(seed, i). The same paths are simulated whatever the
+ * thread count and summed in a fixed order, so the result is bit-identical
+ * on any number of threads and safe to cache.
+ * 
+ * @param p GBM parameters (S0, sigma, T, steps)
+ * @param K Strike price
+ * @param call If true, price a call option; if false, price a put option
+ * @param n_paths Number of Monte Carlo simulation paths
+ * @param r Risk-free interest rate for discounting
+ * @param seed Seed identifying the random streams
+ * @return MCResult Structure containing price estimate and standard error
+ */
+MCResult monte_carlo_price(const GBMParams& p, double K, bool call, std::int64_t n_paths, double r,
+                           std::uint64_t seed);
 
 #endif // PRICER_HPP
@@ -0,0 +1,123 @@
+#ifndef PRICING_CONTEXT_HPP
+#define PRICING_CONTEXT_HPP
+
+#include "pricing_plan.hpp"
+#include "random_utils.hpp"
+#include "reduction_tree.hpp"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Per-caller execution state for the Monte Carlo engine
+ *
+ * A PricingContext owns everything a pricing run needs beyond the plan
+ * itself: a thread budget, a seed sequence, per-thread scratch for the
+ * partial sums and running statistics. Nothing is process-global, so
+ * independent callers (for example the request handlers of a risk server)
+ * can each hold a context and price concurrently with their own thread
+ * counts, without calling omp_set_num_threads().
+ *
+ * A single context is not thread-safe; give each concurrent caller its own.
+ */
+
+/**
+ * @brief Accumulated statistics of the runs executed by a context
+ */
+struct ContextStats {
+    std::uint64_t runs = 0;        // Completed runs (whole plans or ranges)
+    std::uint64_t paths = 0;       // Simulated paths
+    std::uint64_t path_steps = 0;  // Simulated time steps over all paths
+    double seconds = 0.0;          // Wall time spent inside run()
+
+    /**
+     * @brief Throughput over all runs so far
+     * @return double Paths per second (0 before the first run)
+     */
+    double paths_per_second() const { return seconds > 0.0 ? paths / seconds : 0.0; }
+};
+
+class PricingContext {
+public:
+    /**
+     * @brief Create a context with a random seed sequence
+     *
+     * @param threads Worker threads per run; 0 uses the OpenMP default
+     * @throws std::invalid_argument if threads is negative
+     */
+    explicit PricingContext(int threads = 0);
+
+    /**
+     * @brief Create a context with a reproducible seed sequence
+     *
+     * @param threads Worker threads per run; 0 uses the OpenMP default
+     * @param seed Seed of the context's random stream
+     * @throws std::invalid_argument if threads is negative
+     */
+    PricingContext(int threads, std::uint64_t seed);
+
+    /**
+     * @brief Execute a plan with this context's thread budget
+     *
+     * Each thread builds the reduction tree of its own leaves in a scratch
+     * slot and the trees are appended in leaf order, so the estimate is
+     * bit-identical to PricingPlan::run() for any thread count and does
+     * not depend on other contexts running at the same time.
+     *
+     * @param plan Validated pricing plan
+     * @return MCResult Price estimate and standard error
+     */
+    MCResult run(const PricingPlan& plan) noexcept;
+
+    /**
+     * @brief Simulate paths [first_path, first_path + count) of a plan
+     *
+     * The context counterpart of PricingPlan::run_range(), for drivers
+     * that split a valuation into chunks or shards.
+     *
+     * @param plan Validated pricing plan
+     * @param first_path Index of the first path
+     * @param count Number of paths
+     * @return PathStats Sums over the range
+     */
+    PathStats run_range(const PricingPlan& plan, std::uint64_t first_path, std::int64_t count) noexcept;
+
+    /**
+     * @brief Price a European option with a seed drawn from the context
+     *
+     * @param p GBM parameters
+     * @param K Strike price
+     * @param call true for a call, false for a put
+     * @param n_paths Number of Monte Carlo paths
+     * @param r Risk-free interest rate
+     * @return MCResult Price estimate and standard error
+     * @throws std::invalid_argument if any input is out of range
+     */
+    MCResult price(const GBMParams& p, double K, bool call, std::int64_t n_paths, double r);
+
+    /**
+     * @brief Next seed of the context's seed sequence
+     */
+    std::uint64_t next_seed() { return stream.next_u64(); }
+
+    /**
+     * @brief The context's own random stream, for ad-hoc draws
+     */
+    RngStream& rng() { return stream; }
+
+    int threads() const { return n_threads; }
+    const ContextStats& stats() const { return totals; }
+    void reset_stats() { totals = ContextStats(); }
+
+private:
+    // Cache-line aligned so the trees of different threads never share a line
+    struct alignas(64) ThreadPartial {
+        ReductionTree tree;
+    };
+
+    int n_threads;
+    RngStream stream;
+    std::vector<ThreadPartial> scratch;
+    ContextStats totals;
+};
+
+#endif // PRICING_CONTEXT_HPP
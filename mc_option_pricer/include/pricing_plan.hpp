@@ -0,0 +1,310 @@
+#ifndef PRICING_PLAN_HPP
+#define PRICING_PLAN_HPP
+
+#include "gbm.hpp"
+#include "pricer.hpp"
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @brief Compiled, reusable Monte Carlo valuation
+ *
+ * A PricingPlan is built once from the model, rate, payoff and engine
+ * options. Construction performs all input validation and folds every
+ * per-step constant (dt, sqrt(dt), drift, discount factor), so run() has
+ * nothing left to check: it never throws, never allocates, and can be
+ * executed any number of times.
+ */
+
+/**
+ * @brief European payoff description
+ */
+struct PayoffSpec {
+    double K;   // Strike price
+    bool call;  // true for a call, false for a put
+};
+
+/**
+ * @brief Simulation controls
+ */
+struct EngineOptions {
+    std::int64_t n_paths;      // Number of Monte Carlo paths
+    std::uint64_t seed;        // Path i draws from RngStream(seed, i)
+    double drift_shift = 0.0;  // Importance-sampling shift of the terminal
+                               // Brownian driver, in standard deviations
+    bool moment_matching = false;        // Match the terminal driver's mean
+                                         // and variance per batch
+    bool martingale_correction = false;  // Rescale S_T to the forward per batch
+};
+
+/**
+ * @brief Terminal Brownian driver of one path
+ *
+ * Under the exact log-space scheme a path enters S_T only through the sum
+ * of its step normals, so one driver revalues the path under any spot,
+ * volatility, rate or maturity (see ScenarioTerminal).
+ */
+struct TerminalDriver {
+    double z;       // sum_j Z_j, moved by the drift shift a: + a sqrt(steps)
+    double weight;  // Likelihood ratio of the shift (1 without one)
+};
+
+/**
+ * @brief GBM scenario folded into a map from terminal driver to S_T
+ *
+ * S_T = exp(log S0 + (r - sigma^2 / 2) T + sigma sqrt(T / steps) z)
+ */
+struct ScenarioTerminal {
+    double log_S0;
+    double drift;     // (r - sigma^2 / 2) T
+    double vol;       // sigma sqrt(T / steps), per unit of the driver
+    double discount;  // exp(-r T)
+
+    static ScenarioTerminal at(double S0, double sigma, double T, double r, int steps) {
+        return ScenarioTerminal{std::log(S0), (r - 0.5 * sigma * sigma) * T, sigma * std::sqrt(T / steps),
+                                std::exp(-r * T)};
+    }
+
+    double terminal_price(double z) const { return std::exp(log_S0 + drift + vol * z); }
+};
+
+/** @brief Paths per batch of the batch-local corrections */
+const std::int64_t kCorrectionBatchPaths = 4096;
+
+/**
+ * @brief Mergeable sums of discounted payoffs over a set of paths
+ *
+ * Partial results of disjoint path ranges (threads, chunks or shards on
+ * different machines) combine with merge() in any grouping; finish()
+ * turns the total into an estimate.
+ *
+ * The unit of independence is a sample: a single path, or a whole batch
+ * when a batch-local correction couples its paths. sum_sq holds
+ * (sample sum)^2 / (sample paths) per sample, which is the squared payoff
+ * for a single path, so the standard error comes out of the same sums
+ * either way.
+ */
+struct PathStats {
+    std::int64_t count = 0;    // Number of paths
+    std::int64_t samples = 0;  // Number of independent samples
+    double sum = 0.0;          // Sum of discounted payoffs
+    double sum_sq = 0.0;       // Sum of squared sample sums over sample sizes
+
+    void add(double discounted_payoff) {
+        count += 1;
+        samples += 1;
+        sum += discounted_payoff;
+        sum_sq += discounted_payoff * discounted_payoff;
+    }
+
+    void add_batch(std::int64_t paths, double batch_sum) {
+        count += paths;
+        samples += 1;
+        sum += batch_sum;
+        sum_sq += batch_sum * batch_sum / static_cast<double>(paths);
+    }
+
+    void merge(const PathStats& other) {
+        count += other.count;
+        samples += other.samples;
+        sum += other.sum;
+        sum_sq += other.sum_sq;
+    }
+};
+
+/**
+ * @brief Turn accumulated payoff sums into an estimate
+ *
+ * The standard error uses the unbiased sample variance, with
+ * stats.samples - 1 degrees of freedom. Shared by every engine that
+ * accumulates PathStats.
+ *
+ * @param stats Sums over the simulated paths (stats.count > 0)
+ * @return MCResult Mean and standard error over stats.samples samples;
+ *         the error is NaN for fewer than two samples
+ */
+MCResult estimate_price(const PathStats& stats) noexcept;
+
+class PricingPlan {
+public:
+    /**
+     * @brief Validate inputs and precompute the simulation constants
+     *
+     * @param p GBM parameters (S0, sigma, T, steps)
+     * @param r Risk-free interest rate
+     * @param payoff Strike and option type
+     * @param options Path count, seed and drift shift
+     * @throws std::invalid_argument if any input is out of range, or a
+     *         batch correction is enabled with fewer than two full batches
+     *         (2 * kCorrectionBatchPaths paths)
+     */
+    PricingPlan(const GBMParams& p, double r, const PayoffSpec& payoff, const EngineOptions& options);
+
+    /**
+     * @brief Run the simulation
+     *
+     * Paths evolve in log space, x += drift + vol_sqrt_dt * Z, with the
+     * normals drawn in small stack-allocated blocks. With a drift shift a,
+     * every step normal is shifted by a / sqrt(steps), which moves the
+     * terminal normal by a, and payoffs are weighted by the likelihood
+     * ratio exp(-a Z_T - a^2 / 2) of the unshifted terminal normal Z_T, so
+     * the estimate stays unbiased. Repeated runs of the
+     * same plan return the same estimate, on any number of threads.
+     *
+     * With moment_matching or martingale_correction, every reduction leaf
+     * is a batch of kCorrectionBatchPaths paths, corrected on its own:
+     *
+     * - moment matching recenters and rescales the terminal Brownian
+     *   drivers of the batch, sum_j Z_j, to mean 0 and variance steps
+     *   exactly (the European payoff depends on the steps only through
+     *   that sum);
+     * - martingale correction multiplies the batch's S_T by
+     *   F / mean(w S_T), with F = S0 exp(rT) and w the likelihood ratios
+     *   (1 without a drift shift), so the batch reprices the forward.
+     *
+     * Both are streaming: a batch keeps only its terminal drivers. The
+     * paths of a batch are no longer independent, so each batch counts as
+     * one sample of PathStats and the standard error is estimated from
+     * the spread of the batch means. Both corrections are nonlinear in
+     * the batch and leave an O(1/batch) bias, which is why the batches
+     * are much larger than the plain reduction leaves.
+     *
+     * @return MCResult Price estimate and standard error
+     */
+    MCResult run() const noexcept;
+
+    /**
+     * @brief Discounted payoff of a single path
+     *
+     * The building block of run(): path i draws from RngStream(seed, i),
+     * so callers that schedule paths themselves (see PricingContext)
+     * reproduce run() exactly.
+     *
+     * @param i Path index
+     * @return double Discounted payoff of path i, times its likelihood
+     *         ratio when the drift is shifted
+     */
+    double path_payoff(std::uint64_t i) const noexcept;
+
+    /**
+     * @brief Terminal value of path i per unit of spot, S_T / S0
+     *
+     * The path of path_payoff(): without a drift shift, path_payoff(i) is
+     * the discounted payoff at S0 * terminal_growth(i), bit for bit, for
+     * any S0 and strike (see UnitPathCache).
+     *
+     * @param i Path index
+     * @return double exp of the path's simulated log return
+     */
+    double terminal_growth(std::uint64_t i) const noexcept;
+
+    /**
+     * @brief Terminal driver of path i and its likelihood ratio
+     *
+     * Draws path i's normals from RngStream(seed, i) in step order, as
+     * path_payoff() does, for callers that revalue every path under many
+     * scenarios (see ScenarioTerminal).
+     *
+     * @param i Path index
+     * @return TerminalDriver Shifted normal sum and likelihood ratio
+     */
+    TerminalDriver terminal_driver(std::uint64_t i) const noexcept;
+
+    /**
+     * @brief Discounted payoff of a path driven by caller-supplied normals
+     *
+     * Same stepping, drift shift and likelihood ratio as path_payoff(),
+     * for samplers that construct the step normals themselves (see
+     * stratified_sampling.hpp).
+     *
+     * @param Z params().steps standard normals, one per time step
+     * @return double Discounted payoff of the path
+     */
+    double payoff_from_normals(const double* Z) const noexcept;
+
+    /**
+     * @brief Sum paths [first_path, first_path + count) on the calling thread
+     *
+     * Paths are added in index order; this is the leaf of the parallel
+     * reductions in run_range(). With a correction enabled the range is
+     * corrected in batches of kCorrectionBatchPaths paths.
+     *
+     * @param first_path Index of the first path
+     * @param count Number of paths
+     * @return PathStats Sums over the range
+     */
+    PathStats sum_paths(std::uint64_t first_path, std::int64_t count) const noexcept;
+
+    /**
+     * @brief Simulate paths [first_path, first_path + count)
+     *
+     * Runs in parallel like run(). The range is split into leaves of
+     * leaf_paths() paths whose sums are combined in a fixed binary
+     * tree (see ReductionTree), so the result is bit-identical for any
+     * thread count. Indices may exceed the plan's n_paths, which lets
+     * independent shards of one very large valuation run on separate
+     * processes and merge their PathStats afterwards.
+     *
+     * @param first_path Index of the first path
+     * @param count Number of paths
+     * @return PathStats Sums over the range
+     */
+    PathStats run_range(std::uint64_t first_path, std::int64_t count) const noexcept;
+
+    /**
+     * @brief Paths per reduction leaf
+     *
+     * @return std::int64_t kCorrectionBatchPaths with a batch-local
+     *         correction enabled, kReductionLeafPaths otherwise
+     */
+    std::int64_t leaf_paths() const noexcept;
+
+    /**
+     * @brief Turn accumulated payoff sums into an estimate
+     *
+     * @param stats Sums over the simulated paths (stats.count > 0)
+     * @return MCResult estimate_price(stats)
+     */
+    MCResult finish(const PathStats& stats) const noexcept;
+
+    const GBMParams& params() const { return model; }
+    double rate() const { return r; }
+    const PayoffSpec& payoff() const { return spec; }
+    const EngineOptions& options() const { return engine; }
+
+    double dt() const { return time_step; }
+    double drift() const { return step_drift; }
+    double vol_sqrt_dt() const { return step_vol; }
+    double discount_factor() const { return discount; }
+
+private:
+    // Log return of path i; z_sum receives the sum of its normals
+    double log_return(std::uint64_t i, double& z_sum) const noexcept;
+
+    // Payoff at exp(log_price), weighted when the drift is shifted
+    double terminal_payoff(double log_price, double z_sum) const noexcept;
+
+    // Likelihood ratio of the unshifted draws with terminal driver z_sum
+    double likelihood_ratio(double z_sum) const noexcept;
+
+    // Sum of path i's step normals, unshifted
+    double normal_sum(std::uint64_t i) const noexcept;
+
+    // Sum of one batch of at most kCorrectionBatchPaths paths with the
+    // batch-local corrections applied
+    double corrected_batch_sum(std::uint64_t first_path, std::int64_t count) const noexcept;
+
+    GBMParams model;
+    double r;
+    PayoffSpec spec;
+    EngineOptions engine;
+
+    // Folded constants
+    double time_step;    // T / steps
+    double step_drift;   // (r - 0.5*sigma^2) * dt
+    double step_vol;     // sigma * sqrt(dt)
+    double discount;     // exp(-r*T)
+    double step_shift;   // drift_shift / sqrt(steps), added to each normal
+};
+
+#endif // PRICING_PLAN_HPP
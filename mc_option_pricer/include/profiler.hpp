@@ -0,0 +1,159 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Per-phase instrumentation of the pricing hot path
+ *
+ * When the library is compiled with MC_ENABLE_PROFILING (CMake option of
+ * the same name), the Monte Carlo loop attributes cycles to RNG
+ * generation, path stepping, payoff evaluation and reduction, per OpenMP
+ * thread, and counts paths, steps and path allocations. Without the
+ * flag the MC_PROFILE_* macros expand to nothing and the hot path is
+ * unchanged.
+ *
+ * Counters live in one cache-line-sized slot per OpenMP thread number.
+ * Concurrent pricings running in separate OpenMP teams, and thread
+ * numbers past kMaxProfileThreads, share slots; updates are atomic, so
+ * no count is lost, but per-thread figures mix the sharing threads.
+ */
+
+/**
+ * @brief Phases of a Monte Carlo path
+ */
+enum class ProfilePhase : int {
+    Rng = 0,        // Normal variate generation
+    Step = 1,       // Applying the GBM step to the path
+    Payoff = 2,     // Payoff evaluation, discounting and per-path accumulation
+    Reduction = 3,  // Combining per-thread partial sums
+    Count = 4
+};
+
+/**
+ * @brief Event counters
+ */
+enum class ProfileCounter : int {
+    Paths = 0,
+    Steps = 1,
+    Allocations = 2,
+    Count = 3
+};
+
+/**
+ * @brief Snapshot of one thread's counters
+ */
+struct ThreadProfile {
+    std::uint64_t cycles[static_cast<int>(ProfilePhase::Count)];
+    std::uint64_t counts[static_cast<int>(ProfileCounter::Count)];
+};
+
+/**
+ * @brief Snapshot of all threads that recorded anything
+ */
+struct ProfileReport {
+    bool enabled;                        // Was the library built with profiling?
+    std::vector<int> thread_ids;         // OpenMP thread number of each entry
+    std::vector<ThreadProfile> threads;
+
+    /**
+     * @brief Sum over all threads
+     */
+    ThreadProfile total() const;
+};
+
+/**
+ * @brief Maximum OpenMP thread number that is tracked separately
+ *
+ * Higher thread numbers share the last slot.
+ */
+const int kMaxProfileThreads = 256;
+
+/**
+ * @brief True if the library was compiled with MC_ENABLE_PROFILING
+ */
+bool profiler_enabled();
+
+/**
+ * @brief Zero all counters
+ */
+void profiler_reset();
+
+/**
+ * @brief Copy the current counters
+ */
+ProfileReport profiler_snapshot();
+
+/**
+ * @brief Read the CPU cycle counter (TSC on x86-64, virtual counter on AArch64)
+ */
+inline std::uint64_t profiler_cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    std::uint32_t lo, hi;
+    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+    return (static_cast<std::uint64_t>(hi) << 32) | lo;
+#elif defined(__aarch64__)
+    std::uint64_t value;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Storage for one thread's counters, padded to its own cache line
+ *
+ * A slot may be shared by several threads, so updates are relaxed
+ * fetch_add; without contention this costs about as much as a plain add.
+ */
+struct alignas(64) ProfileSlot {
+    std::atomic<std::uint64_t> cycles[static_cast<int>(ProfilePhase::Count)];
+    std::atomic<std::uint64_t> counts[static_cast<int>(ProfileCounter::Count)];
+};
+
+/**
+ * @brief Slot of the calling OpenMP thread
+ */
+ProfileSlot& profiler_slot();
+
+inline void profiler_add(std::atomic<std::uint64_t>& counter, std::uint64_t value) {
+    counter.fetch_add(value, std::memory_order_relaxed);
+}
+
+/**
+ * @brief RAII timer attributing its lifetime to a phase
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfilePhase phase)
+        : slot(profiler_slot()), index(static_cast<int>(phase)), start(profiler_cycles()) {}
+    ~ProfileScope() {
+        profiler_add(slot.cycles[index], profiler_cycles() - start);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfileSlot& slot;
+    int index;
+    std::uint64_t start;
+};
+
+#define MC_PROFILE_CONCAT_INNER(a, b) a##b
+#define MC_PROFILE_CONCAT(a, b) MC_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef MC_ENABLE_PROFILING
+#define MC_PROFILE_SCOPE(phase) \
+    ProfileScope MC_PROFILE_CONCAT(mc_profile_scope_, __LINE__)(ProfilePhase::phase)
+#define MC_PROFILE_COUNT(counter, n) \
+    profiler_add(profiler_slot().counts[static_cast<int>(ProfileCounter::counter)], (n))
+#else
+#define MC_PROFILE_SCOPE(phase) ((void)0)
+#define MC_PROFILE_COUNT(counter, n) ((void)0)
+#endif
+
+#endif // PROFILER_HPP
@@ -0,0 +1,249 @@
+#ifndef REDUCTION_TREE_HPP
+#define REDUCTION_TREE_HPP
+
+#include "pricing_plan.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Fixed-shape reduction of PathStats over a sequence of leaves
+ *
+ * Floating-point addition is not associative, so a reduction whose
+ * grouping follows the thread count or the scheduler changes the last
+ * bits of the estimate from one machine to the next. A ReductionTree
+ * instead combines leaves (blocks of kReductionLeafPaths consecutive paths)
+ * in one canonical binary tree that depends only on the number of leaves:
+ *
+ * - a node covers leaves [first, first + 2^level) with first a multiple of
+ *   2^level, and its value is merge(left half, right half);
+ * - push() merges a node with its left sibling as soon as both exist, so
+ *   any thread can build the nodes of its own contiguous leaf range and
+ *   the per-thread trees are appended in leaf order afterwards;
+ * - total() folds the remaining nodes from the right.
+ *
+ * Every node is computed by the same sequence of additions whichever
+ * thread builds it, so the total is bit-identical for any thread count.
+ * The storage is a fixed array: the tree never allocates.
+ */
+
+/** @brief Paths summed sequentially into one leaf of the tree */
+const std::int64_t kReductionLeafPaths = 256;
+
+class ReductionTree {
+public:
+    struct Node {
+        PathStats stats;
+        std::int64_t first;  // First leaf covered
+        int level;           // Covers 2^level leaves
+    };
+
+    /**
+     * @brief Add the sums of leaf `leaf` (the leaves must arrive in order)
+     *
+     * @param leaf Leaf index within the reduced range
+     * @param stats Sums over the paths of the leaf
+     */
+    void add_leaf(std::int64_t leaf, const PathStats& stats) { push(Node{stats, leaf, 0}); }
+
+    /**
+     * @brief Append the nodes of a tree built over the following leaves
+     */
+    void append(const ReductionTree& other) {
+        for (int i = 0; i < other.size; ++i) {
+            push(other.nodes[i]);
+        }
+    }
+
+    /**
+     * @brief Sum over all leaves added so far
+     */
+    PathStats total() const {
+        PathStats result;
+        if (size == 0) {
+            return result;
+        }
+        result = nodes[size - 1].stats;
+        for (int i = size - 2; i >= 0; --i) {
+            result = combine(nodes[i].stats, result);
+        }
+        return result;
+    }
+
+    void clear() { size = 0; }
+
+    /**
+     * @brief Pending nodes, left to right, for saving a partial tree
+     *
+     * Pushing them in order into an empty tree (restore()) rebuilds the
+     * same state.
+     */
+    int node_count() const { return size; }
+    const Node& node(int i) const { return nodes[i]; }
+
+    /**
+     * @brief Append a node saved with node()
+     *
+     * @return bool false if the tree is full or the node does not follow
+     *         the ones already present
+     */
+    bool restore(const Node& node) {
+        if (size == kMaxNodes || node.level < 0 || node.level > 62 || node.first < 0 ||
+            (node.first & ((std::int64_t(1) << node.level) - 1)) != 0 ||
+            (size > 0 && nodes[size - 1].first + (std::int64_t(1) << nodes[size - 1].level) != node.first) ||
+            (size == 0 && node.first != 0)) {
+            return false;
+        }
+        push(node);
+        return true;
+    }
+
+private:
+    static PathStats combine(PathStats left, const PathStats& right) {
+        left.merge(right);
+        return left;
+    }
+
+    void push(Node node) {
+        // Merge with the left sibling while the node completes one
+        while (size > 0 && nodes[size - 1].level == node.level &&
+               (nodes[size - 1].first & ((std::int64_t(2) << node.level) - 1)) == 0) {
+            const Node& left = nodes[size - 1];
+            node = Node{combine(left.stats, node.stats), left.first, node.level + 1};
+            --size;
+        }
+        nodes[size++] = node;
+    }
+
+    // A range of up to 2^63 leaves needs at most two nodes per level
+    static const int kMaxNodes = 128;
+
+    Node nodes[kMaxNodes];
+    int size = 0;
+};
+
+/**
+ * @brief Paths and sums handled by one call of a reduce_leaves() leaf function
+ */
+struct LeafTask {
+    std::int64_t leaf;      // Leaf index
+    std::int64_t first;     // First path of the leaf
+    int count;              // Paths in the leaf (kReductionLeafPaths but the last)
+    std::size_t sum_begin;  // Sums to fill: [sum_begin, sum_end)
+    std::size_t sum_end;
+};
+
+/** @brief Most estimates one reduce_leaves() call may sum (one tree each) */
+const std::size_t kMaxReductionSums = 8192;
+
+/** @brief Most leaves per thread simulated between two reduction passes */
+const std::int64_t kReductionRoundLeaves = 8;
+
+/** @brief Bound on the round buffer, which caps the leaves per round */
+const std::size_t kReductionRoundBytes = std::size_t(4) << 20;
+
+/**
+ * @brief Sum several estimates over paths [0, n_paths) on n_threads threads
+ *
+ * Leaves of kReductionLeafPaths paths are simulated in rounds of up to
+ * kReductionRoundLeaves leaves per thread into a leaf-major buffer of
+ * PathStats (at most kReductionRoundBytes unless a single leaf per thread
+ * needs more), and after each round the threads split the sums and add
+ * the round's leaves to one ReductionTree per sum, in leaf order. Memory
+ * is therefore one tree per sum plus the round buffer. When path i draws from
+ * RngStream(seed, i), every total is therefore bit-identical on any
+ * thread count.
+ *
+ * leaf_fn(const LeafTask& task, PathStats* sums) adds the task's paths to
+ * sums[n] for n in [task.sum_begin, task.sum_end); those entries arrive
+ * zeroed. With split_sums, when a round has fewer leaves than threads the
+ * sums are split into blocks as well and each leaf is visited once per
+ * block, so that every thread has work; leaf_fn must then write only its
+ * own range.
+ *
+ * @param n_threads Threads of the parallel region
+ * @param n_paths Number of paths (positive)
+ * @param n_sums Number of estimates
+ * @param leaf_fn Fills the sums of one leaf
+ * @param split_sums Allow splitting the sums across threads
+ * @return std::vector<PathStats> The n_sums totals
+ * @throws std::invalid_argument if n_sums exceeds kMaxReductionSums
+ */
+template <typename LeafFn>
+std::vector<PathStats> reduce_leaves(int n_threads, std::int64_t n_paths, std::size_t n_sums, LeafFn leaf_fn,
+                                     bool split_sums = false) {
+    if (n_sums > kMaxReductionSums) {
+        throw std::invalid_argument("At most " + std::to_string(kMaxReductionSums) +
+                                    " estimates can be summed in one pass");
+    }
+    const std::int64_t leaves = (n_paths + kReductionLeafPaths - 1) / kReductionLeafPaths;
+    const std::int64_t per_thread = std::max<std::int64_t>(
+        1, std::min<std::int64_t>(kReductionRoundLeaves,
+                                  static_cast<std::int64_t>(kReductionRoundBytes /
+                                                            (static_cast<std::size_t>(n_threads) *
+                                                             std::max<std::size_t>(n_sums, 1) * sizeof(PathStats)))));
+    const std::int64_t round_leaves =
+        std::max<std::int64_t>(1, std::min(leaves, static_cast<std::int64_t>(n_threads) * per_thread));
+    const std::int64_t blocks =
+        split_sums && round_leaves < n_threads
+            ? std::max<std::int64_t>(1, std::min(static_cast<std::int64_t>(n_sums),
+                                                 (n_threads + round_leaves - 1) / round_leaves))
+            : 1;
+    const std::int64_t sums = static_cast<std::int64_t>(n_sums);
+
+    std::vector<ReductionTree> trees(n_sums);
+    std::vector<PathStats> rows(static_cast<std::size_t>(round_leaves) * n_sums);
+
+#ifdef _OPENMP
+    #pragma omp parallel num_threads(n_threads)
+#endif
+    for (std::int64_t round_first = 0; round_first < leaves; round_first += round_leaves) {
+        const std::int64_t round_count = std::min(round_leaves, leaves - round_first);
+        const std::int64_t tasks = round_count * blocks;
+
+        // Tasks are leaf-major; each writes its own slice of a leaf's row
+#ifdef _OPENMP
+        #pragma omp for schedule(static)
+#endif
+        for (std::int64_t t = 0; t < tasks; ++t) {
+            const std::int64_t block = t % blocks;
+            LeafTask task;
+            task.leaf = round_first + t / blocks;
+            task.first = task.leaf * kReductionLeafPaths;
+            task.count = static_cast<int>(std::min(kReductionLeafPaths, n_paths - task.first));
+            task.sum_begin = static_cast<std::size_t>(block * sums / blocks);
+            task.sum_end = static_cast<std::size_t>((block + 1) * sums / blocks);
+
+            PathStats* row = &rows[static_cast<std::size_t>(t / blocks) * n_sums];
+            std::fill(row + task.sum_begin, row + task.sum_end, PathStats());
+            leaf_fn(task, row);
+        }
+
+        // Every sum's leaves go into its tree in leaf order
+        {
+            MC_PROFILE_SCOPE(Reduction);
+#ifdef _OPENMP
+            #pragma omp for schedule(static)
+#endif
+            for (std::int64_t n = 0; n < sums; ++n) {
+                for (std::int64_t l = 0; l < round_count; ++l) {
+                    trees[static_cast<std::size_t>(n)].add_leaf(round_first + l,
+                                                                rows[static_cast<std::size_t>(l * sums + n)]);
+                }
+            }
+        }
+    }
+
+    std::vector<PathStats> totals;
+    totals.reserve(n_sums);
+    for (const ReductionTree& tree : trees) {
+        totals.push_back(tree.total());
+    }
+    return totals;
+}
+
+#endif // REDUCTION_TREE_HPP
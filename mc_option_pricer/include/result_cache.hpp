@@ -0,0 +1,199 @@
+#ifndef RESULT_CACHE_HPP
+#define RESULT_CACHE_HPP
+
+#include "gbm.hpp"
+#include "pricer.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Content-addressed cache for pricing results
+ *
+ * This module memoizes valuations keyed on their canonicalized inputs.
+ * Results live in an in-memory LRU and, optionally, in a directory of
+ * small files named by the key hash so that separate processes and
+ * later runs can reuse them.
+ */
+
+/**
+ * @brief Pricing method a cached result was produced by
+ */
+enum class PricingMethod : std::uint8_t {
+    MonteCarlo = 1,
+    BlackScholes = 2
+};
+
+/**
+ * @brief Canonical description of a single valuation request
+ *
+ * Two keys compare equal exactly when their canonical byte encodings are
+ * equal. For closed-form keys the simulation fields (steps, n_paths,
+ * seed) are ignored.
+ */
+struct PricingKey {
+    PricingMethod method;
+    bool call;
+    double S0;
+    double K;
+    double r;
+    double sigma;
+    double T;
+    int steps;
+    std::int64_t n_paths;
+    std::uint64_t seed;
+
+    /**
+     * @brief Key for a seeded Monte Carlo valuation
+     */
+    static PricingKey monte_carlo(const GBMParams& p, double K, bool call,
+                                  std::int64_t n_paths, double r, std::uint64_t seed);
+
+    /**
+     * @brief Key for a Black-Scholes closed-form valuation
+     */
+    static PricingKey black_scholes(double S0, double K, double r, double sigma,
+                                    double T, bool call);
+
+    /**
+     * @brief Fixed-layout little-endian encoding of the key
+     *
+     * Doubles are canonicalized first (-0.0 becomes +0.0) and fields that
+     * do not apply to the method are zeroed.
+     *
+     * @throws std::invalid_argument if any numeric field is NaN
+     */
+    std::vector<unsigned char> canonical_bytes() const;
+
+    /**
+     * @brief 64-bit FNV-1a hash of canonical_bytes()
+     */
+    std::uint64_t hash() const;
+
+    bool operator==(const PricingKey& other) const;
+};
+
+/**
+ * @brief 64-bit FNV-1a hash of a byte buffer
+ */
+std::uint64_t fnv1a_64(const unsigned char* data, std::size_t size,
+                       std::uint64_t basis = 0xcbf29ce484222325ULL);
+
+/**
+ * @brief Canonical hash of GBM parameters
+ *
+ * Hashes S0, sigma, T and steps in a fixed order with the same
+ * canonicalization as PricingKey, so equal parameters always hash equal.
+ */
+std::uint64_t hash_gbm_params(const GBMParams& p);
+
+/**
+ * @brief Hit/miss counters of a ResultCache
+ */
+struct CacheStats {
+    std::uint64_t hits;         // Served from memory
+    std::uint64_t disk_hits;    // Served from the on-disk store
+    std::uint64_t misses;       // Computed by the pricer
+    std::uint64_t evictions;    // Dropped from memory by the LRU policy
+    std::uint64_t disk_writes;  // Results persisted to disk
+
+    /**
+     * @brief Fraction of lookups served without recomputation
+     */
+    double hit_rate() const;
+};
+
+/**
+ * @brief LRU result cache in front of the Monte Carlo and closed-form pricers
+ *
+ * All member functions are thread-safe. Pricing on a miss runs outside
+ * the internal lock, so two threads missing on the same key may both
+ * compute it; since seeded pricing is reproducible the stored result is
+ * the same either way.
+ */
+class ResultCache {
+public:
+    /**
+     * @brief Create a cache
+     *
+     * @param capacity Maximum number of results kept in memory (0 disables the memory tier)
+     * @param disk_dir Directory for persisted results; empty disables the disk tier
+     */
+    explicit ResultCache(std::size_t capacity = 4096, const std::string& disk_dir = "");
+
+    /**
+     * @brief Cached seeded Monte Carlo valuation
+     *
+     * Only seeded valuations are cacheable: an unseeded run is a fresh
+     * random estimate every time.
+     */
+    MCResult price_monte_carlo(const GBMParams& p, double K, bool call, std::int64_t n_paths,
+                               double r, std::uint64_t seed);
+
+    /**
+     * @brief Cached Black-Scholes call price
+     */
+    double price_bs_call(double S0, double K, double r, double sigma, double T);
+
+    /**
+     * @brief Cached Black-Scholes put price
+     */
+    double price_bs_put(double S0, double K, double r, double sigma, double T);
+
+    /**
+     * @brief Look a key up in memory, then on disk
+     *
+     * A disk hit is promoted into the memory tier.
+     *
+     * @return bool True if found; the result is written to out
+     */
+    bool lookup(const PricingKey& key, MCResult& out);
+
+    /**
+     * @brief Insert a result into memory and (if enabled) onto disk
+     */
+    void store(const PricingKey& key, const MCResult& result);
+
+    /**
+     * @brief Change the memory capacity, evicting as needed
+     */
+    void set_capacity(std::size_t capacity);
+
+    /**
+     * @brief Drop all in-memory entries (the disk tier is left untouched)
+     */
+    void clear();
+
+    std::size_t size() const;
+    std::size_t capacity() const;
+    CacheStats stats() const;
+    void reset_stats();
+
+private:
+    struct KeyHasher {
+        std::size_t operator()(const PricingKey& key) const {
+            return static_cast<std::size_t>(key.hash());
+        }
+    };
+
+    using Entry = std::pair<PricingKey, MCResult>;
+
+    void insert_locked(const PricingKey& key, const MCResult& result);
+    void evict_locked();
+    bool load_from_disk(const PricingKey& key, MCResult& out) const;
+    bool save_to_disk(const PricingKey& key, const MCResult& result) const;
+    std::string disk_path(const PricingKey& key) const;
+
+    mutable std::mutex mutex;
+    std::size_t max_entries;
+    std::string directory;
+    std::list<Entry> lru;  // Most recently used at the front
+    std::unordered_map<PricingKey, std::list<Entry>::iterator, KeyHasher> index;
+    CacheStats counters;
+};
+
+#endif // RESULT_CACHE_HPP
@@ -0,0 +1,64 @@
+#ifndef SCENARIO_GRID_HPP
+#define SCENARIO_GRID_HPP
+
+#include "pricing_context.hpp"
+#include "pricing_plan.hpp"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Scenario grid revaluation on common random numbers
+ *
+ * A stress run revalues an option at every point of a grid of spot,
+ * volatility and rate shocks. Pricing each point independently repeats
+ * the random walk N x M x L times; here every scenario is revalued on the
+ * same paths: the terminal drivers of a block of paths are drawn once
+ * (PricingPlan::terminal_driver()) and each scenario costs one exp and
+ * one payoff per path (see ScenarioTerminal). Shared paths also make the
+ * differences between scenarios far less noisy than their prices.
+ *
+ * The scenario sums go through reduce_leaves() with split_sums, so small
+ * path counts still spread the scenarios over every thread.
+ */
+
+/**
+ * @brief Shocks applied to the plan's inputs; the grid is their product
+ */
+struct ScenarioGrid {
+    std::vector<double> spot_shocks = {0.0};  // Relative spot shifts: S0 (1 + shock)
+    std::vector<double> vol_shocks = {0.0};   // Absolute volatility shifts
+    std::vector<double> rate_shocks = {0.0};  // Absolute rate shifts
+};
+
+/**
+ * @brief Prices of every scenario with their standard errors
+ *
+ * prices is indexed by spot, then volatility, then rate; use at().
+ */
+struct ScenarioCube {
+    std::vector<double> spots;   // Shocked spots, one per spot shock
+    std::vector<double> vols;    // Shocked volatilities
+    std::vector<double> rates;   // Shocked rates
+    std::vector<MCResult> prices;
+
+    const MCResult& at(std::size_t spot, std::size_t vol, std::size_t rate) const {
+        return prices[(spot * vols.size() + vol) * rates.size() + rate];
+    }
+};
+
+/**
+ * @brief Revalue a plan at every scenario of a grid
+ *
+ * @param context Context supplying the threads
+ * @param plan Validated pricing plan (model, payoff, n_paths, seed and
+ *        drift shift are used)
+ * @param grid Spot, volatility and rate shocks
+ * @return ScenarioCube Price and standard error of every scenario
+ * @throws std::invalid_argument if an axis is empty, a shocked spot is not
+ *         positive, a shocked volatility is negative, a shock is not
+ *         finite, the plan uses a batch correction, or the grid has more
+ *         than kMaxReductionSums scenarios
+ */
+ScenarioCube revalue_scenarios(PricingContext& context, const PricingPlan& plan, const ScenarioGrid& grid);
+
+#endif // SCENARIO_GRID_HPP
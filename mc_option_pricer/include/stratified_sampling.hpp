@@ -0,0 +1,67 @@
+#ifndef STRATIFIED_SAMPLING_HPP
+#define STRATIFIED_SAMPLING_HPP
+
+#include "pricing_context.hpp"
+#include "pricing_plan.hpp"
+#include <cstdint>
+
+/**
+ * @brief Stratified and Latin hypercube sampling of a pricing plan
+ *
+ * Both schemes construct the step normals of each path themselves and
+ * evaluate them with PricingPlan::payoff_from_normals(), so the model,
+ * payoff and any importance-sampling shift are those of the plan.
+ *
+ * Stratified: the terminal normal Z_T = W_T / sqrt(T) is drawn from one of
+ * H equiprobable strata, u = (h + V) / H, Z_T = N^-1(u), with the paths
+ * split evenly across strata. When steps > 1 the intermediate Brownian
+ * values are filled in with the conditional Brownian bridge
+ *
+ *   B_k = B_{k-1} + (B_n - B_{k-1}) / m + sqrt((m - 1) / m) * xi,
+ *
+ * (B in units of sqrt(dt), m steps remaining), so every path is an exact
+ * GBM path whose terminal value lies in its stratum. The estimate is
+ * sum_h p_h mean_h with p_h = 1/H, and its variance is the stratified
+ * sum_h p_h^2 s_h^2 / n_h with the unbiased within-stratum variances s_h^2.
+ *
+ * Latin hypercube: R independent hypercubes of about n/R paths each. In a
+ * hypercube of m paths, step j of path k uses stratum pi_j(k) of m, where
+ * pi_j is a keyed pseudo-random permutation (a Feistel network with cycle
+ * walking, so no permutation table is stored). A single hypercube has no
+ * unbiased variance estimator, so the error is measured across the R
+ * hypercube means.
+ *
+ * Path i draws its uniforms from RngStream(seed, i). Each stratum or
+ * hypercube is simulated entirely by one thread and the results are
+ * combined in index order, so the estimate is the same on any thread
+ * count.
+ */
+
+enum class SamplingScheme {
+    Stratified,     // Strata of the terminal normal, Brownian bridge in between
+    LatinHypercube  // Latin hypercube across the step normals
+};
+
+/**
+ * @brief Scheme and its parameters
+ */
+struct SamplingOptions {
+    SamplingScheme scheme = SamplingScheme::Stratified;
+    std::int64_t strata = 1024;  // Stratified: equiprobable strata of Z_T
+    int replications = 32;       // LatinHypercube: independent hypercubes
+};
+
+/**
+ * @brief Run a plan with stratified or Latin hypercube sampling
+ *
+ * @param context Context supplying the threads
+ * @param plan Validated pricing plan (its n_paths and seed are used)
+ * @param options Sampling scheme and parameters
+ * @return MCResult Price estimate and the scheme's standard error
+ * @throws std::invalid_argument if a stratum would get fewer than 2 paths,
+ *         or if there are fewer than 2 replications or fewer paths than
+ *         replications
+ */
+MCResult stratified_run(PricingContext& context, const PricingPlan& plan, const SamplingOptions& options);
+
+#endif // STRATIFIED_SAMPLING_HPP
@@ -0,0 +1,160 @@
+#ifndef TERM_STRUCTURE_HPP
+#define TERM_STRUCTURE_HPP
+
+#include "pricing_context.hpp"
+#include "pricing_plan.hpp"
+#include <vector>
+
+/**
+ * @brief Time-dependent rate and volatility term structures
+ *
+ * With a short rate r(t) and a volatility sigma(t) the exact log-space
+ * step over [t_j, t_j+1] is
+ *
+ *   log S += int r dt - 1/2 int sigma^2 dt + sqrt(int sigma^2 dt) Z_j,
+ *
+ * so a curve never has to be evaluated inside the path loop. A
+ * TermStructurePlan integrates both curves once over every step of the
+ * simulation grid into a drift table and a diffusion table; stepping a
+ * path is then one table lookup per step, exactly as cheap as the flat
+ * PricingPlan. The integrals are exact for the supported curve shapes, so
+ * knots between grid points cause no discretization bias.
+ *
+ * The terminal law is that of Black-Scholes with the average rate and the
+ * root-mean-square volatility over [0, T], which bs_term_structure()
+ * prices in closed form as the accuracy reference.
+ */
+
+/**
+ * @brief How a curve behaves between its knots
+ */
+enum class CurveInterpolation {
+    PiecewiseConstant,  // values[i] on (times[i-1], times[i]], with times[-1] = 0
+    Linear              // Linear between knots, flat before the first and after the last
+};
+
+/**
+ * @brief A rate or volatility curve of time
+ *
+ * Beyond the last knot every curve keeps its last value.
+ */
+class TermCurve {
+public:
+    /**
+     * @brief Constant curve
+     */
+    static TermCurve flat(double value);
+
+    /**
+     * @brief Curve equal to values[i] on (times[i-1], times[i]]
+     *
+     * @param times Right ends of the pieces, strictly increasing and positive
+     * @param values Value on each piece
+     * @throws std::invalid_argument if the knots are malformed
+     */
+    static TermCurve piecewise_constant(std::vector<double> times, std::vector<double> values);
+
+    /**
+     * @brief Curve interpolated linearly between (times[i], values[i])
+     *
+     * @param times Knot times, strictly increasing and non-negative
+     * @param values Value at each knot
+     * @throws std::invalid_argument if the knots are malformed
+     */
+    static TermCurve linear(std::vector<double> times, std::vector<double> values);
+
+    /** @brief Value at time t */
+    double value(double t) const;
+
+    /** @brief Integral of the curve over [a, b] */
+    double integral(double a, double b) const;
+
+    /** @brief Integral of the squared curve over [a, b] */
+    double integral_of_square(double a, double b) const;
+
+    /** @brief Smallest value the curve takes */
+    double min_value() const;
+
+private:
+    TermCurve(std::vector<double> times, std::vector<double> values, CurveInterpolation interpolation);
+
+    // Integrals over [a, b] of f and of f^2
+    void integrate(double a, double b, double& sum, double& sum_sq) const;
+
+    std::vector<double> times;
+    std::vector<double> values;
+    CurveInterpolation interpolation;
+};
+
+/**
+ * @brief GBM with a short-rate curve and a volatility curve
+ */
+struct TermStructureModel {
+    double S0;        // Initial stock price
+    double T;         // Time to maturity (years)
+    int steps;        // Number of uniform time steps
+    TermCurve rate;   // Short rate r(t)
+    TermCurve vol;    // Volatility sigma(t)
+};
+
+/**
+ * @brief Compiled Monte Carlo valuation under term structures
+ *
+ * Like PricingPlan, construction validates every input and compiles the
+ * per-step tables; run() can be executed any number of times and throws
+ * nothing but std::bad_alloc from the reduction buffers. With flat curves
+ * the plan draws the same normals as the PricingPlan of the same inputs.
+ */
+class TermStructurePlan {
+public:
+    /**
+     * @brief Validate the inputs and compile the step tables
+     *
+     * @param model Spot, maturity, grid and curves
+     * @param payoff Strike and option type
+     * @param options Paths and seed (no drift shift or batch corrections)
+     * @throws std::invalid_argument if an input is out of range, the
+     *         volatility curve goes negative, or the engine shifts the
+     *         drift or uses a batch correction
+     */
+    TermStructurePlan(const TermStructureModel& model, const PayoffSpec& payoff, const EngineOptions& options);
+
+    /**
+     * @brief Run the valuation
+     *
+     * @param context Context supplying the threads
+     * @return MCResult Price estimate and standard error
+     */
+    MCResult run(PricingContext& context) const;
+
+    /** @brief int r dt - 1/2 int sigma^2 dt over each step */
+    const std::vector<double>& drift_table() const { return drift; }
+
+    /** @brief sqrt(int sigma^2 dt) over each step */
+    const std::vector<double>& diffusion_table() const { return diffusion; }
+
+    /** @brief exp(-int_0^T r dt) */
+    double discount_factor() const { return discount; }
+
+private:
+    double S0;
+    PayoffSpec spec;
+    EngineOptions engine;
+    std::vector<double> drift;
+    std::vector<double> diffusion;
+    double discount;
+};
+
+/**
+ * @brief Closed-form price under term structures
+ *
+ * Black-Scholes with the average rate int_0^T r dt / T and the
+ * root-mean-square volatility sqrt(int_0^T sigma^2 dt / T).
+ *
+ * @param model Spot, maturity and curves (steps is not used)
+ * @param payoff Strike and option type
+ * @return double Option price
+ */
+double bs_term_structure(const TermStructureModel& model, const PayoffSpec& payoff);
+
+#endif // TERM_STRUCTURE_HPP
@@ -0,0 +1,102 @@
+#ifndef UNIT_PATH_CACHE_HPP
+#define UNIT_PATH_CACHE_HPP
+
+#include "pricing_context.hpp"
+#include "pricing_plan.hpp"
+#include "result_cache.hpp"
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Cache of unit-spot terminal values for instant repricing
+ *
+ * Under GBM a path scales linearly with S0: S_T = S0 * g with a growth
+ * factor g = exp(log return) that depends on (sigma, T, r, steps) and the
+ * random streams only. The cache keeps the growth factors of every path
+ * of a (sigma, T, r, steps, n_paths, seed) set, so a new spot or strike
+ * costs one pass of S0 * g through the payoff instead of a new random
+ * walk.
+ *
+ * The growth factors are those of PricingPlan::terminal_growth() and the
+ * payoff pass is reduced like run(), so a cached price is bit-identical
+ * to PricingContext::run() of the same plan.
+ *
+ * Entries are evicted least recently used first; an entry holds 8 bytes
+ * per path. All member functions are thread-safe. Missing growth factors
+ * are simulated outside the internal lock, so two threads missing on the
+ * same set may both simulate it; the stored values are the same either
+ * way.
+ */
+
+class UnitPathCache {
+public:
+    /**
+     * @brief Create a cache
+     *
+     * @param capacity Maximum number of path sets kept in memory
+     */
+    explicit UnitPathCache(std::size_t capacity = 8);
+
+    /**
+     * @brief Price a plan from its cached path set
+     *
+     * Simulates the growth factors of the plan's path set on first use.
+     *
+     * @param context Context supplying the threads
+     * @param plan Plan without drift shift or batch corrections
+     * @return MCResult Price estimate and standard error
+     * @throws std::invalid_argument if the plan shifts the drift or uses a
+     *         batch correction
+     */
+    MCResult price(PricingContext& context, const PricingPlan& plan);
+
+    /**
+     * @brief Price several payoffs at the plan's spot in one pass
+     *
+     * Each leaf of growth factors is read once and stays in cache while
+     * every payoff is evaluated on it; the plan's own payoff is ignored.
+     *
+     * @param context Context supplying the threads
+     * @param plan Plan without drift shift or batch corrections
+     * @param payoffs Strikes and option types to price
+     * @return std::vector<MCResult> One estimate per payoff, in order
+     * @throws std::invalid_argument if the plan shifts the drift, uses a
+     *         batch correction or any strike is not positive
+     */
+    std::vector<MCResult> price(PricingContext& context, const PricingPlan& plan,
+                                const std::vector<PayoffSpec>& payoffs);
+
+    /**
+     * @brief Drop all path sets
+     */
+    void clear();
+
+    std::size_t size() const;
+    std::size_t capacity() const;
+    CacheStats stats() const;
+
+private:
+    using Growths = std::shared_ptr<const std::vector<double>>;
+
+    struct KeyHasher {
+        std::size_t operator()(const PricingKey& key) const {
+            return static_cast<std::size_t>(key.hash());
+        }
+    };
+
+    using Entry = std::pair<PricingKey, Growths>;
+
+    Growths growths(PricingContext& context, const PricingPlan& plan);
+
+    mutable std::mutex mutex;
+    std::size_t max_entries;
+    std::list<Entry> lru;  // Most recently used at the front
+    std::unordered_map<PricingKey, std::list<Entry>::iterator, KeyHasher> index;
+    CacheStats counters;
+};
+
+#endif // UNIT_PATH_CACHE_HPP
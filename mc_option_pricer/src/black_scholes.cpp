@@ -83,3 +83,33 @@ double bs_put(double S0, double K, double r, double sigma, double T) {
     
     return put_price;
 }
+
+BSGreeks bs_greeks(double S0, double K, double r, double sigma, double T, bool call) {
+    // Validate input parameters
+    if (S0 <= 0.0) {
+        throw std::invalid_argument("Stock price S0 must be positive");
+    }
+    if (K <= 0.0) {
+        throw std::invalid_argument("Strike price K must be positive");
+    }
+    if (sigma <= 0.0) {
+        throw std::invalid_argument("Volatility sigma must be positive for Greeks");
+    }
+    if (T <= 0.0) {
+        throw std::invalid_argument("Time to maturity T must be positive");
+    }
+    
+    double sqrt_T = std::sqrt(T);
+    double d1 = (std::log(S0 / K) + (r + 0.5 * sigma * sigma) * T) / (sigma * sqrt_T);
+    double d2 = d1 - sigma * sqrt_T;
+    double phi_d1 = std::exp(-0.5 * d1 * d1) / std::sqrt(2.0 * M_PI);
+    double discounted_K = K * std::exp(-r * T);
+    
+    BSGreeks greeks;
+    greeks.delta = call ? cumulative_normal(d1) : cumulative_normal(d1) - 1.0;
+    greeks.gamma = phi_d1 / (S0 * sigma * sqrt_T);
+    greeks.vega = S0 * phi_d1 * sqrt_T;
+    greeks.theta = -S0 * phi_d1 * sigma / (2.0 * sqrt_T) +
+                   (call ? -r * discounted_K * cumulative_normal(d2) : r * discounted_K * cumulative_normal(-d2));
+    return greeks;
+}
@@ -0,0 +1,273 @@
+#include "chunked_run.hpp"
+#include "result_cache.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <unistd.h>
+
+namespace {
+
+const char kCheckpointMagic[4] = {'M', 'C', 'C', 'K'};
+// Version 2: thread-count independent chunk sums, no bound thread count
+// Version 3: independent sample count (batch-corrected runs)
+// Version 4: RngStream::uniform() on 52 bits, strictly inside (0, 1)
+// Version 5: pending chunk tree nodes in place of the flat total
+const std::uint32_t kCheckpointVersion = 5;
+
+// Fixed-size header following the magic
+struct CheckpointRecord {
+    std::uint32_t version;
+    std::uint64_t fingerprint;
+    std::int64_t chunk_paths;
+    std::int64_t next_path;
+    std::int32_t nodes;
+};
+
+template <typename T>
+bool write_value(std::FILE* file, const T& value) {
+    return std::fwrite(&value, sizeof(T), 1, file) == 1;
+}
+
+template <typename T>
+bool read_value(std::FILE* file, T& value) {
+    return std::fread(&value, sizeof(T), 1, file) == 1;
+}
+
+} // namespace
+
+ChunkedRun::ChunkedRun(const PricingPlan& plan, std::int64_t chunk_paths)
+    : plan(plan), chunk(chunk_paths) {
+    const std::int64_t leaf = plan.leaf_paths();
+    const std::int64_t leaves = chunk_paths / leaf;
+    if (chunk_paths <= 0 || chunk_paths % leaf != 0 || (leaves & (leaves - 1)) != 0) {
+        throw std::invalid_argument("Chunk size must be a power-of-two multiple of " + std::to_string(leaf) +
+                                    " paths");
+    }
+}
+
+void ChunkedRun::run_chunk(PricingContext& context) {
+    if (done()) {
+        return;
+    }
+    std::int64_t count = std::min(chunk, plan.options().n_paths - position);
+    chunks.add_leaf(position / chunk, context.run_range(plan, static_cast<std::uint64_t>(position), count));
+    position += count;
+}
+
+MCResult ChunkedRun::run(PricingContext& context) {
+    run_until(context, RunLimits());
+    return result();
+}
+
+BoundedResult ChunkedRun::run_until(PricingContext& context, const RunLimits& limits) {
+    using clock = std::chrono::steady_clock;
+    const clock::time_point start = clock::now();
+    const std::int64_t start_path = position;
+    clock::time_point last_checkpoint = start;
+    clock::time_point last_progress = start;
+    double slowest_chunk = 0.0;  // Seconds; 0 until a chunk has been timed
+
+    auto report = [&](clock::time_point now) {
+        double elapsed = std::chrono::duration<double>(now - start).count();
+        double rate = elapsed > 0.0 ? (position - start_path) / elapsed : 0.0;
+        MCResult estimate = plan.finish(chunks.total());
+
+        ProgressRecord record;
+        record.paths_done = position;
+        record.n_paths = plan.options().n_paths;
+        record.price = estimate.price;
+        record.stderr = estimate.stderr;
+        record.paths_per_second = rate;
+        record.elapsed_seconds = elapsed;
+        record.eta_seconds = rate > 0.0 ? (record.n_paths - position) / rate : 0.0;
+        progress(record);
+    };
+
+    StopReason reason = StopReason::Completed;
+    while (!done()) {
+        clock::time_point before = clock::now();
+        if (limits.cancel && limits.cancel->cancelled()) {
+            reason = StopReason::Cancelled;
+            break;
+        }
+        if (before >= limits.deadline ||
+            (slowest_chunk > 0.0 &&
+             std::chrono::duration<double>(limits.deadline - before).count() < slowest_chunk)) {
+            reason = StopReason::Deadline;
+            break;
+        }
+
+        run_chunk(context);
+        clock::time_point now = clock::now();
+        slowest_chunk = std::max(slowest_chunk, std::chrono::duration<double>(now - before).count());
+        if (done()) {
+            break;
+        }
+
+        if (!checkpoint_file.empty() &&
+            std::chrono::duration<double>(now - last_checkpoint).count() >= checkpoint_interval) {
+            save_checkpoint(checkpoint_file);
+            last_checkpoint = now;
+        }
+        if (progress && std::chrono::duration<double>(now - last_progress).count() >= progress_interval) {
+            report(now);
+            last_progress = now;
+        }
+    }
+
+    // A completed checkpoint resumes straight to the final result; a
+    // stopped one continues where this call left off
+    if (!checkpoint_file.empty()) {
+        save_checkpoint(checkpoint_file);
+    }
+    if (progress && position > 0) {
+        report(clock::now());
+    }
+
+    BoundedResult bounded;
+    bounded.paths_completed = position;
+    bounded.reason = reason;
+    if (position > 0) {
+        bounded.estimate = plan.finish(chunks.total());
+    } else {
+        bounded.estimate.price = std::numeric_limits<double>::quiet_NaN();
+        bounded.estimate.stderr = std::numeric_limits<double>::quiet_NaN();
+    }
+    return bounded;
+}
+
+MCResult ChunkedRun::result() const {
+    if (position == 0) {
+        throw std::logic_error("No paths have been simulated yet");
+    }
+    return plan.finish(chunks.total());
+}
+
+void ChunkedRun::set_checkpoint(const std::string& file, double interval_seconds) {
+    checkpoint_file = file;
+    checkpoint_interval = interval_seconds;
+}
+
+void ChunkedRun::set_progress(ProgressCallback callback, double interval_seconds) {
+    progress = std::move(callback);
+    progress_interval = interval_seconds;
+}
+
+std::uint64_t ChunkedRun::fingerprint() const {
+    const PayoffSpec& payoff = plan.payoff();
+    const EngineOptions& options = plan.options();
+    PricingKey key = PricingKey::monte_carlo(plan.params(), payoff.K, payoff.call,
+                                             options.n_paths, plan.rate(), options.seed);
+    // Shifted and corrected runs simulate different paths; plain plans keep
+    // the fingerprint they always had
+    std::uint64_t hash = key.hash();
+    if (options.drift_shift != 0.0) {
+        hash = fnv1a_64(reinterpret_cast<const unsigned char*>(&options.drift_shift),
+                        sizeof(options.drift_shift), hash);
+    }
+    if (options.moment_matching || options.martingale_correction) {
+        const unsigned char corrections = static_cast<unsigned char>(
+            (options.moment_matching ? 1 : 0) | (options.martingale_correction ? 2 : 0));
+        hash = fnv1a_64(&corrections, 1, hash);
+    }
+    return hash;
+}
+
+void ChunkedRun::save_checkpoint(const std::string& file) const {
+    CheckpointRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.version = kCheckpointVersion;
+    record.fingerprint = fingerprint();
+    record.chunk_paths = chunk;
+    record.next_path = position;
+    record.nodes = chunks.node_count();
+
+    std::string temp_path = file + ".tmp";
+    std::FILE* out = std::fopen(temp_path.c_str(), "wb");
+    if (!out) {
+        throw std::runtime_error("Cannot open checkpoint file " + temp_path + ": " + std::strerror(errno));
+    }
+    bool ok = std::fwrite(kCheckpointMagic, 1, 4, out) == 4 &&
+              write_value(out, record.version) &&
+              write_value(out, record.fingerprint) &&
+              write_value(out, record.chunk_paths) &&
+              write_value(out, record.next_path) &&
+              write_value(out, record.nodes);
+    for (int i = 0; ok && i < record.nodes; ++i) {
+        const ReductionTree::Node& node = chunks.node(i);
+        ok = write_value(out, node.first) &&
+             write_value(out, static_cast<std::int32_t>(node.level)) &&
+             write_value(out, node.stats.count) &&
+             write_value(out, node.stats.samples) &&
+             write_value(out, node.stats.sum) &&
+             write_value(out, node.stats.sum_sq);
+    }
+
+    // Make the data durable before the rename publishes it
+    ok = ok && std::fflush(out) == 0 && ::fsync(fileno(out)) == 0;
+    ok = std::fclose(out) == 0 && ok;
+    if (!ok || std::rename(temp_path.c_str(), file.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+        throw std::runtime_error("Cannot write checkpoint file " + file);
+    }
+}
+
+bool ChunkedRun::resume(const std::string& file) {
+    std::FILE* in = std::fopen(file.c_str(), "rb");
+    if (!in) {
+        return false;
+    }
+
+    char magic[4];
+    CheckpointRecord record;
+    bool ok = std::fread(magic, 1, 4, in) == 4 &&
+              std::memcmp(magic, kCheckpointMagic, 4) == 0 &&
+              read_value(in, record.version) &&
+              record.version == kCheckpointVersion &&
+              read_value(in, record.fingerprint) &&
+              read_value(in, record.chunk_paths) &&
+              read_value(in, record.next_path) &&
+              read_value(in, record.nodes) &&
+              record.nodes >= 0 && record.nodes <= 128;
+    ReductionTree tree;
+    for (int i = 0; ok && i < record.nodes; ++i) {
+        ReductionTree::Node node;
+        std::int32_t level;
+        ok = read_value(in, node.first) &&
+             read_value(in, level) &&
+             read_value(in, node.stats.count) &&
+             read_value(in, node.stats.samples) &&
+             read_value(in, node.stats.sum) &&
+             read_value(in, node.stats.sum_sq);
+        node.level = level;
+        ok = ok && node.stats.samples >= 0 && node.stats.samples <= node.stats.count && tree.restore(node);
+    }
+    std::fclose(in);
+
+    if (!ok) {
+        throw std::runtime_error("Corrupt or unsupported checkpoint file " + file);
+    }
+    if (record.fingerprint != fingerprint()) {
+        throw std::runtime_error("Checkpoint " + file + " was written for a different valuation");
+    }
+    if (record.chunk_paths != chunk) {
+        throw std::runtime_error("Checkpoint " + file + " was written with a different chunk size");
+    }
+    // The nodes must cover exactly the chunks before next_path
+    const std::int64_t covered =
+        record.nodes == 0 ? 0
+                          : tree.node(record.nodes - 1).first + (std::int64_t(1) << tree.node(record.nodes - 1).level);
+    if (record.next_path < 0 || record.next_path > plan.options().n_paths ||
+        tree.total().count != record.next_path || covered != (record.next_path + chunk - 1) / chunk) {
+        throw std::runtime_error("Corrupt checkpoint file " + file);
+    }
+
+    position = record.next_path;
+    chunks = tree;
+    return true;
+}
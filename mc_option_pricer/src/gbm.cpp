@@ -1,8 +1,14 @@
 #include "gbm.hpp"
 #include "random_utils.hpp"
+#include "profiler.hpp"
 #include <cmath>
+#include <stdexcept>
 
-std::vector<double> simulate_path(const GBMParams& p, double r) {
+namespace {
+
+// Shared path simulation; next_normal supplies the Z draws
+template <typename NormalSource>
+std::vector<double> simulate_path_impl(const GBMParams& p, double r, NormalSource next_normal) {
     // Validate input parameters
     if (p.S0 <= 0.0) {
         throw std::invalid_argument("Initial stock price S0 must be positive");
@@ -20,27 +26,61 @@ std::vector<double> simulate_path(const GBMParams& p, double r) {
         throw std::invalid_argument("Risk-free rate r must be non-negative");
     }
     
-    // Calculate time step size
+    // Calculate time step size and the per-step drift and diffusion scale
     double dt = p.T / p.steps;
+    double drift_term = (r - 0.5 * p.sigma * p.sigma) * dt;
+    double vol_sqrt_dt = p.sigma * std::sqrt(dt);
     
     // Initialize result vector with initial price
     std::vector<double> path(p.steps + 1);
     path[0] = p.S0;
+    MC_PROFILE_COUNT(Allocations, 1);
+    
+#ifdef MC_ENABLE_PROFILING
+    // Draw all normals first, using the path itself as scratch space, so
+    // random number generation and stepping can be timed separately
+    {
+        MC_PROFILE_SCOPE(Rng);
+        for (int i = 1; i <= p.steps; ++i) {
+            path[i] = next_normal();
+        }
+    }
     
+    // Simulate the path step by step, replacing each Z with the price
+    MC_PROFILE_SCOPE(Step);
+    double current_price = p.S0;
+    for (int i = 1; i <= p.steps; ++i) {
+        double Z = path[i];
+        double diffusion_term = vol_sqrt_dt * Z;
+        current_price = current_price * std::exp(drift_term + diffusion_term);
+        path[i] = current_price;
+    }
+#else
     // Simulate the path step by step
     double current_price = p.S0;
     for (int i = 1; i <= p.steps; ++i) {
         // Generate standard normal random variable
-        double Z = randn();
+        double Z = next_normal();
         
         // Calculate next price using GBM formula
         // S_{t+1} = S_t * exp((r - 0.5*sigma^2)*dt + sigma*sqrt(dt)*Z)
-        double drift_term = (r - 0.5 * p.sigma * p.sigma) * dt;
-        double diffusion_term = p.sigma * std::sqrt(dt) * Z;
+        double diffusion_term = vol_sqrt_dt * Z;
         
         current_price = current_price * std::exp(drift_term + diffusion_term);
         path[i] = current_price;
     }
+#endif
+    MC_PROFILE_COUNT(Steps, p.steps);
     
     return path;
 }
+
+} // namespace
+
+std::vector<double> simulate_path(const GBMParams& p, double r) {
+    return simulate_path_impl(p, r, [] { return randn(); });
+}
+
+std::vector<double> simulate_path(const GBMParams& p, double r, RngStream& rng) {
+    return simulate_path_impl(p, r, [&rng] { return rng.normal(); });
+}
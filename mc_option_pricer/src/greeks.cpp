@@ -0,0 +1,121 @@
+#include "greeks.hpp"
+#include "payoffs.hpp"
+#include "reduction_tree.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Scenarios revalued around every point, in this order
+enum Scenario { kBase, kSpotUp, kSpotDown, kVolUp, kVolDown, kEarlier, kScenarios };
+
+// Estimates accumulated per point, in this order
+enum Estimate { kPrice, kDelta, kGamma, kVega, kTheta, kEstimates };
+
+// A point of a ladder with its bump sizes resolved
+struct Point {
+    GreeksPoint inputs;
+    double spot_step;  // h S
+    ScenarioTerminal scenarios[kScenarios];
+};
+
+Point make_point(double S0, double sigma, double T, double r, int steps, const GreeksOptions& options) {
+    const double h = options.spot_bump;
+    const double v = options.vol_bump;
+    const double tau = options.maturity_bump;
+    if (S0 <= 0.0 || sigma - v < 0.0 || T - tau <= 0.0) {
+        throw std::invalid_argument("Bumped spot, volatility or maturity out of range");
+    }
+
+    Point point;
+    point.inputs = GreeksPoint{S0, sigma, T, {}, {}, {}, {}, {}};
+    point.spot_step = h * S0;
+    point.scenarios[kBase] = ScenarioTerminal::at(S0, sigma, T, r, steps);
+    point.scenarios[kSpotUp] = ScenarioTerminal::at(S0 * (1.0 + h), sigma, T, r, steps);
+    point.scenarios[kSpotDown] = ScenarioTerminal::at(S0 * (1.0 - h), sigma, T, r, steps);
+    point.scenarios[kVolUp] = ScenarioTerminal::at(S0, sigma + v, T, r, steps);
+    point.scenarios[kVolDown] = ScenarioTerminal::at(S0, sigma - v, T, r, steps);
+    point.scenarios[kEarlier] = ScenarioTerminal::at(S0, sigma, T - tau, r, steps);
+    return point;
+}
+
+} // namespace
+
+GreeksReport bump_and_revalue(PricingContext& context, const PricingPlan& plan, const GreeksOptions& options) {
+    const GBMParams& p = plan.params();
+    const EngineOptions& engine = plan.options();
+    const PayoffSpec payoff = plan.payoff();
+    const double r = plan.rate();
+    const int steps = p.steps;
+
+    if (!(options.spot_bump > 0.0 && options.spot_bump < 1.0) || !(options.vol_bump > 0.0) ||
+        !(options.maturity_bump > 0.0)) {
+        throw std::invalid_argument("Bump sizes must be positive (spot bump below 1)");
+    }
+    if (engine.moment_matching || engine.martingale_correction) {
+        throw std::invalid_argument("Bump-and-revalue Greeks do not support batch corrections");
+    }
+
+    // Base point first, then the ladders in order
+    std::vector<Point> points;
+    points.push_back(make_point(p.S0, p.sigma, p.T, r, steps, options));
+    for (double shift : options.spot_ladder) {
+        points.push_back(make_point(p.S0 * (1.0 + shift), p.sigma, p.T, r, steps, options));
+    }
+    for (double shift : options.vol_ladder) {
+        points.push_back(make_point(p.S0, p.sigma + shift, p.T, r, steps, options));
+    }
+    for (double shift : options.maturity_ladder) {
+        points.push_back(make_point(p.S0, p.sigma, p.T + shift, r, steps, options));
+    }
+    const std::size_t n_sums = points.size() * kEstimates;
+
+    auto leaf_fn = [&](const LeafTask& task, PathStats* sums) {
+        for (int k = 0; k < task.count; ++k) {
+            // One pass over the path's normals serves every scenario
+            const TerminalDriver driver = plan.terminal_driver(static_cast<std::uint64_t>(task.first + k));
+
+            for (std::size_t n = 0; n < points.size(); ++n) {
+                const Point& point = points[n];
+                double V[kScenarios];
+                for (int s = 0; s < kScenarios; ++s) {
+                    const ScenarioTerminal& t = point.scenarios[s];
+                    double S_T = t.terminal_price(driver.z);
+                    double value = payoff.call ? european_call(S_T, payoff.K) : european_put(S_T, payoff.K);
+                    V[s] = driver.weight * t.discount * value;
+                }
+
+                const double hS = point.spot_step;
+                PathStats* point_sums = &sums[n * kEstimates];
+                point_sums[kPrice].add(V[kBase]);
+                point_sums[kDelta].add((V[kSpotUp] - V[kSpotDown]) / (2.0 * hS));
+                point_sums[kGamma].add((V[kSpotUp] - 2.0 * V[kBase] + V[kSpotDown]) / (hS * hS));
+                point_sums[kVega].add((V[kVolUp] - V[kVolDown]) / (2.0 * options.vol_bump));
+                point_sums[kTheta].add((V[kEarlier] - V[kBase]) / options.maturity_bump);
+            }
+        }
+    };
+    const std::vector<PathStats> totals = reduce_leaves(context.threads(), engine.n_paths, n_sums, leaf_fn);
+
+    std::vector<GreeksPoint> results;
+    for (std::size_t k = 0; k < points.size(); ++k) {
+        GreeksPoint result = points[k].inputs;
+        const PathStats* point_totals = &totals[k * kEstimates];
+        result.price = plan.finish(point_totals[kPrice]);
+        result.delta = plan.finish(point_totals[kDelta]);
+        result.gamma = plan.finish(point_totals[kGamma]);
+        result.vega = plan.finish(point_totals[kVega]);
+        result.theta = plan.finish(point_totals[kTheta]);
+        results.push_back(result);
+    }
+
+    GreeksReport report;
+    auto next = results.begin();
+    report.base = *next++;
+    report.spot_ladder.assign(next, next + options.spot_ladder.size());
+    next += options.spot_ladder.size();
+    report.vol_ladder.assign(next, next + options.vol_ladder.size());
+    next += options.vol_ladder.size();
+    report.maturity_ladder.assign(next, results.end());
+    return report;
+}
@@ -0,0 +1,78 @@
+#include "importance_sampling.hpp"
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Root of a function that changes sign once on (0, inf): g(x) > 0 below
+// the root if falling, g(x) < 0 below it if rising
+template <typename F>
+double bisect_positive(F g) {
+    const bool falling = g(1e-12) > 0.0;
+    double lo = 0.0;
+    double hi = 1.0;
+    while ((g(hi) > 0.0) == falling && hi < 1e6) {
+        lo = hi;
+        hi *= 2.0;
+    }
+    for (int i = 0; i < 200 && hi - lo > 1e-12 * hi; ++i) {
+        double mid = 0.5 * (lo + hi);
+        if ((g(mid) > 0.0) == falling) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return 0.5 * (lo + hi);
+}
+
+} // namespace
+
+double optimal_drift_shift(const GBMParams& p, double r, const PayoffSpec& payoff) {
+    // Reuse the plan's input validation
+    PricingPlan plan(p, r, payoff, EngineOptions{1, 0});
+
+    const double s = p.sigma * std::sqrt(p.T);
+    if (s == 0.0) {
+        return 0.0;
+    }
+    // Terminal normal at which the option is at the money
+    const double m = (r - 0.5 * p.sigma * p.sigma) * p.T;
+    const double z_K = (std::log(payoff.K / p.S0) - m) / s;
+
+    if (payoff.call) {
+        // z = z_K + x with S = K exp(s x): s / (1 - exp(-s x)) = z_K + x
+        double x = bisect_positive([s, z_K](double x) {
+            return s / -std::expm1(-s * x) - z_K - x;
+        });
+        return z_K + x;
+    }
+    // z = z_K - y with S = K exp(-s y): -s / (exp(s y) - 1) = z_K - y
+    double y = bisect_positive([s, z_K](double y) {
+        return -s / std::expm1(s * y) - z_K + y;
+    });
+    return z_K - y;
+}
+
+ImportanceSamplingReport importance_sampling_report(PricingContext& context, const GBMParams& p,
+                                                    double r, const PayoffSpec& payoff,
+                                                    std::int64_t n_paths, std::uint64_t seed) {
+    ImportanceSamplingReport report;
+    report.shift = optimal_drift_shift(p, r, payoff);
+
+    PricingPlan shifted(p, r, payoff, EngineOptions{n_paths, seed, report.shift});
+    PricingPlan plain(p, r, payoff, EngineOptions{n_paths, seed});
+    report.shifted = context.run(shifted);
+    report.plain = context.run(plain);
+
+    // No sampling error under the shift (e.g. zero volatility): no ratio
+    if (report.shifted.stderr == 0.0) {
+        report.variance_reduction = std::numeric_limits<double>::quiet_NaN();
+    } else if (report.plain.stderr == 0.0) {
+        report.variance_reduction = std::numeric_limits<double>::infinity();
+    } else {
+        double ratio = report.plain.stderr / report.shifted.stderr;
+        report.variance_reduction = ratio * ratio;
+    }
+    return report;
+}
@@ -0,0 +1,310 @@
+#include "local_vol.hpp"
+#include "payoffs.hpp"
+#include "profiler.hpp"
+#include "random_utils.hpp"
+#include "reduction_tree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+void check_increasing(const std::vector<double>& values, double lower, const char* message) {
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (!std::isfinite(values[i]) || values[i] < lower || (i > 0 && values[i] <= values[i - 1])) {
+            throw std::invalid_argument(message);
+        }
+    }
+}
+
+// Natural cubic spline through (x[i], y[i]), flat outside [x.front(), x.back()]
+class Spline {
+public:
+    Spline(std::vector<double> x, std::vector<double> y) : x(std::move(x)), y(std::move(y)) {
+        const std::size_t n = this->x.size();
+        m.assign(n, 0.0);
+        if (n < 3) {
+            return;
+        }
+        // Tridiagonal system for the second derivatives, natural ends
+        std::vector<double> c(n, 0.0);
+        for (std::size_t i = 1; i + 1 < n; ++i) {
+            const double h0 = this->x[i] - this->x[i - 1];
+            const double h1 = this->x[i + 1] - this->x[i];
+            const double rhs = 6.0 * ((this->y[i + 1] - this->y[i]) / h1 - (this->y[i] - this->y[i - 1]) / h0);
+            const double diag = 2.0 * (h0 + h1) - h0 * c[i - 1];
+            c[i] = h1 / diag;
+            m[i] = (rhs - h0 * m[i - 1]) / diag;
+        }
+        for (std::size_t i = n - 2; i > 0; --i) {
+            m[i] -= c[i] * m[i + 1];
+        }
+    }
+
+    double operator()(double t) const {
+        if (t <= x.front()) {
+            return y.front();
+        }
+        if (t >= x.back()) {
+            return y.back();
+        }
+        std::size_t i = static_cast<std::size_t>(std::upper_bound(x.begin(), x.end(), t) - x.begin()) - 1;
+        const double h = x[i + 1] - x[i];
+        const double a = (x[i + 1] - t) / h;
+        const double b = (t - x[i]) / h;
+        return a * y[i] + b * y[i + 1] + ((a * a * a - a) * m[i] + (b * b * b - b) * m[i + 1]) * h * h / 6.0;
+    }
+
+private:
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> m;  // Second derivatives at the knots
+};
+
+// Total implied variance w(T, y), y = log(K / F(T))
+class TotalVariance {
+public:
+    TotalVariance(const ImpliedVolSurface& implied, double S0, double r) : maturities(implied.maturities) {
+        const std::size_t n_strikes = implied.strikes.size();
+        for (std::size_t i = 0; i < maturities.size(); ++i) {
+            const double forward = S0 * std::exp(r * maturities[i]);
+            std::vector<double> y;
+            std::vector<double> vols;
+            for (std::size_t j = 0; j < n_strikes; ++j) {
+                y.push_back(std::log(implied.strikes[j] / forward));
+                vols.push_back(implied.vols[i * n_strikes + j]);
+            }
+            smiles.emplace_back(std::move(y), std::move(vols));
+        }
+    }
+
+    double operator()(double T, double y) const {
+        if (T <= maturities.front()) {
+            const double vol = smiles.front()(y);
+            return vol * vol * T;
+        }
+        if (T >= maturities.back()) {
+            const double vol = smiles.back()(y);
+            return vol * vol * T;
+        }
+        std::size_t i = static_cast<std::size_t>(
+            std::upper_bound(maturities.begin(), maturities.end(), T) - maturities.begin()) - 1;
+        const double v0 = smiles[i](y);
+        const double v1 = smiles[i + 1](y);
+        const double w0 = v0 * v0 * maturities[i];
+        const double w1 = v1 * v1 * maturities[i + 1];
+        return w0 + (T - maturities[i]) / (maturities[i + 1] - maturities[i]) * (w1 - w0);
+    }
+
+private:
+    std::vector<double> maturities;
+    std::vector<Spline> smiles;  // Implied volatility against y, per maturity
+};
+
+// Finite-difference steps of the Dupire derivatives
+const double kMaturityStep = 1e-4;
+const double kMoneynessStep = 1e-3;
+
+} // namespace
+
+LocalVolSurface::LocalVolSurface(std::vector<double> times, double spot_min, double spot_max, int spot_nodes,
+                                 std::vector<double> vols)
+    : slice_times(std::move(times)), nodes(spot_nodes), values(std::move(vols)) {
+    if (slice_times.empty()) {
+        throw std::invalid_argument("Local volatility surface needs at least one slice");
+    }
+    check_increasing(slice_times, 0.0, "Slice times must be finite, non-negative and strictly increasing");
+    if (!(spot_min > 0.0 && spot_max > spot_min && std::isfinite(spot_max)) || spot_nodes < 2) {
+        throw std::invalid_argument("Spot nodes need 0 < spot_min < spot_max and at least 2 nodes");
+    }
+    if (values.size() != slice_times.size() * static_cast<std::size_t>(spot_nodes)) {
+        throw std::invalid_argument("Local volatility surface needs one value per slice and node");
+    }
+    for (double v : values) {
+        if (!(v >= 0.0) || !std::isfinite(v)) {
+            throw std::invalid_argument("Local volatilities must be finite and non-negative");
+        }
+    }
+    x_min = std::log(spot_min);
+    dx = (std::log(spot_max) - x_min) / (spot_nodes - 1);
+}
+
+double LocalVolSurface::value(double t, double S) const {
+    // Node and weight in log S, flat outside the grid
+    double u = std::min(std::max((std::log(S) - x_min) / dx, 0.0), static_cast<double>(nodes - 1));
+    int n = std::min(static_cast<int>(u), nodes - 2);
+    double w = u - n;
+    auto at = [&](std::size_t i) {
+        const double* s = slice(i);
+        return s[n] + w * (s[n + 1] - s[n]);
+    };
+
+    if (t <= slice_times.front()) {
+        return at(0);
+    }
+    if (t >= slice_times.back()) {
+        return at(slice_times.size() - 1);
+    }
+    std::size_t i = static_cast<std::size_t>(
+        std::upper_bound(slice_times.begin(), slice_times.end(), t) - slice_times.begin()) - 1;
+    double a = (t - slice_times[i]) / (slice_times[i + 1] - slice_times[i]);
+    return at(i) + a * (at(i + 1) - at(i));
+}
+
+LocalVolSurface dupire_local_vol(const ImpliedVolSurface& implied, double S0, double r,
+                                 const std::vector<double>& times, double spot_min, double spot_max, int spot_nodes) {
+    if (implied.maturities.empty() || implied.strikes.empty() ||
+        implied.vols.size() != implied.maturities.size() * implied.strikes.size()) {
+        throw std::invalid_argument("Implied surface needs one volatility per maturity and strike");
+    }
+    check_increasing(implied.maturities, 0.0, "Implied maturities must be finite, positive and strictly increasing");
+    check_increasing(implied.strikes, 0.0, "Implied strikes must be finite, positive and strictly increasing");
+    if (implied.maturities.front() <= 0.0 || implied.strikes.front() <= 0.0) {
+        throw std::invalid_argument("Implied maturities and strikes must be positive");
+    }
+    for (double v : implied.vols) {
+        if (!(v > 0.0) || !std::isfinite(v)) {
+            throw std::invalid_argument("Implied volatilities must be finite and positive");
+        }
+    }
+    if (S0 <= 0.0) {
+        throw std::invalid_argument("Initial stock price S0 must be positive");
+    }
+
+    // Validate the output grid before the Dupire pass
+    LocalVolSurface grid(times, spot_min, spot_max, spot_nodes,
+                         std::vector<double>(times.size() * static_cast<std::size_t>(spot_nodes), 0.0));
+
+    const TotalVariance w(implied, S0, r);
+    const double h = kMoneynessStep;
+    std::vector<double> vols;
+    vols.reserve(times.size() * static_cast<std::size_t>(spot_nodes));
+    for (double t : times) {
+        // Central differences in T where T - h stays positive
+        const double T = std::max(t, kMaturityStep);
+        const double T_lo = std::max(T - kMaturityStep, 0.5 * kMaturityStep);
+        const double forward = S0 * std::exp(r * T);
+        for (int n = 0; n < spot_nodes; ++n) {
+            const double S = std::exp(grid.log_spot_min() + n * grid.log_spot_step());
+            const double y = std::log(S / forward);
+
+            const double w0 = w(T, y);
+            const double w_T = (w(T + kMaturityStep, y) - w(T_lo, y)) / (T + kMaturityStep - T_lo);
+            const double w_up = w(T, y + h);
+            const double w_down = w(T, y - h);
+            const double w_y = (w_up - w_down) / (2.0 * h);
+            const double w_yy = (w_up - 2.0 * w0 + w_down) / (h * h);
+
+            const double denominator = 1.0 - y * w_y / w0 +
+                                       0.25 * (-0.25 - 1.0 / w0 + y * y / (w0 * w0)) * w_y * w_y + 0.5 * w_yy;
+            double variance = w_T / denominator;
+            if (!(denominator > 0.0) || !(variance > kMinLocalVariance)) {
+                variance = kMinLocalVariance;
+            }
+            vols.push_back(std::sqrt(variance));
+        }
+    }
+    return LocalVolSurface(times, spot_min, spot_max, spot_nodes, std::move(vols));
+}
+
+LocalVolPlan::LocalVolPlan(const LocalVolModel& model, const LocalVolSurface& surface, const PayoffSpec& payoff,
+                           const EngineOptions& options)
+    : model(model), spec(payoff), engine(options) {
+    // Validate input parameters
+    if (model.S0 <= 0.0) {
+        throw std::invalid_argument("Initial stock price S0 must be positive");
+    }
+    if (model.T <= 0.0) {
+        throw std::invalid_argument("Time to maturity T must be positive");
+    }
+    if (model.steps <= 0) {
+        throw std::invalid_argument("Number of steps must be positive");
+    }
+    if (model.r < 0.0) {
+        throw std::invalid_argument("Risk-free rate r must be non-negative");
+    }
+    if (payoff.K <= 0.0) {
+        throw std::invalid_argument("Strike price K must be positive");
+    }
+    if (options.n_paths <= 0) {
+        throw std::invalid_argument("Number of paths must be positive");
+    }
+    if (options.drift_shift != 0.0 || options.moment_matching || options.martingale_correction) {
+        throw std::invalid_argument("Local volatility plans do not support drift shift or batch corrections");
+    }
+
+    // Resample the surface at each step's start time on its own nodes, so
+    // the path loop interpolates in log S only
+    x_min = surface.log_spot_min();
+    inv_dx = 1.0 / surface.log_spot_step();
+    nodes = surface.spot_nodes();
+    dt = model.T / model.steps;
+    sqrt_dt = std::sqrt(dt);
+    discount = std::exp(-model.r * model.T);
+    slices.resize(static_cast<std::size_t>(model.steps) * static_cast<std::size_t>(nodes));
+    for (int j = 0; j < model.steps; ++j) {
+        for (int n = 0; n < nodes; ++n) {
+            const double S = std::exp(x_min + n * surface.log_spot_step());
+            slices[static_cast<std::size_t>(j) * nodes + n] = surface.value(j * dt, S);
+        }
+    }
+}
+
+MCResult LocalVolPlan::run(PricingContext& context) const {
+    const double log_S0 = std::log(model.S0);
+    const double last_node = static_cast<double>(nodes - 1);
+
+    // One leaf of streams per thread, reserved once so leaves never allocate
+    std::vector<std::vector<RngStream>> scratch(static_cast<std::size_t>(context.threads()));
+    for (std::vector<RngStream>& streams : scratch) {
+        streams.reserve(kReductionLeafPaths);
+    }
+
+    auto leaf_fn = [&](const LeafTask& task, PathStats* sums) {
+        double x[kReductionLeafPaths];  // log S of each path
+        double z[kReductionLeafPaths];
+
+#ifdef _OPENMP
+        std::vector<RngStream>& rngs = scratch[static_cast<std::size_t>(omp_get_thread_num())];
+#else
+        std::vector<RngStream>& rngs = scratch[0];
+#endif
+        rngs.clear();
+        for (int k = 0; k < task.count; ++k) {
+            rngs.emplace_back(engine.seed, static_cast<std::uint64_t>(task.first + k));
+            x[k] = log_S0;
+        }
+
+        for (int j = 0; j < model.steps; ++j) {
+            {
+                MC_PROFILE_SCOPE(Rng);
+                for (int k = 0; k < task.count; ++k) {
+                    z[k] = rngs[static_cast<std::size_t>(k)].normal();
+                }
+            }
+            MC_PROFILE_SCOPE(Step);
+            const double* s = &slices[static_cast<std::size_t>(j) * nodes];
+            for (int k = 0; k < task.count; ++k) {
+                // Linear interpolation in log S, flat outside the nodes
+                double u = std::min(std::max((x[k] - x_min) * inv_dx, 0.0), last_node);
+                int n = std::min(static_cast<int>(u), nodes - 2);
+                double w = u - n;
+                double sigma = s[n] + w * (s[n + 1] - s[n]);
+                x[k] += (model.r - 0.5 * sigma * sigma) * dt + sigma * sqrt_dt * z[k];
+            }
+        }
+
+        MC_PROFILE_SCOPE(Payoff);
+        for (int k = 0; k < task.count; ++k) {
+            double S_T = std::exp(x[k]);
+            double payoff = spec.call ? european_call(S_T, spec.K) : european_put(S_T, spec.K);
+            sums[0].add(discount * payoff);
+        }
+        MC_PROFILE_COUNT(Paths, task.count);
+    };
+    return estimate_price(reduce_leaves(context.threads(), engine.n_paths, 1, leaf_fn).front());
+}
@@ -4,12 +4,26 @@
 #include <cmath>
 #include <chrono>
 #include <iomanip>
+#include <sstream>
 #include <string>
+#include <cerrno>
+#include <csignal>
+#include <climits>
+#include <cstdint>
 #include <cstdlib>
 #include "random_utils.hpp"
 #include "gbm.hpp"
 #include "pricer.hpp"
+#include "pricing_context.hpp"
+#include "chunked_run.hpp"
+#include "mlmc.hpp"
+#include "importance_sampling.hpp"
+#include "stratified_sampling.hpp"
+#include "greeks.hpp"
+#include "scenario_grid.hpp"
+#include "maturity_surface.hpp"
 #include "black_scholes.hpp"
+#include "profiler.hpp"
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -29,6 +43,25 @@ void print_usage(const char* program_name) {
     std::cout << "  -T <value>      Time to maturity (default: 1.0)\n";
     std::cout << "  -steps <value>  Number of time steps (default: 252)\n";
     std::cout << "  -paths <value>  Number of Monte Carlo paths (default: 1000000)\n";
+    std::cout << "  -seed <value>   Seed of the random streams (default: random)\n";
+    std::cout << "  -checkpoint <file>  Checkpoint the run to <file>.call/<file>.put (needs -seed)\n";
+    std::cout << "  -checkpoint-every <seconds>  Checkpoint interval (default: 60)\n";
+    std::cout << "  --resume        Continue from the checkpoint files if present\n";
+    std::cout << "  --progress      Stream NDJSON progress records to stderr\n";
+    std::cout << "  -progress-every <seconds>  Progress interval (default: 1)\n";
+    std::cout << "  -deadline-ms <ms>  Stop at this wall-time budget with the best estimate so far\n";
+    std::cout << "  -mlmc <rmse>    Also price with multilevel Monte Carlo to this RMSE\n";
+    std::cout << "  --importance    Also price with importance sampling and report the gain\n";
+    std::cout << "  -sampling <scheme>  Also price with stratified or lhs (Latin hypercube) sampling\n";
+    std::cout << "  --moment-matching  Match the terminal normals' mean and variance per batch\n";
+    std::cout << "  --martingale    Rescale each batch's S_T to reprice the forward\n";
+    std::cout << "  --greeks        Also report bump-and-revalue Greeks with their errors\n";
+    std::cout << "  -stress-spots <list>  Revalue at relative spot shocks, e.g. -0.1,0,0.1\n";
+    std::cout << "  -stress-vols <list>   Revalue at absolute volatility shocks\n";
+    std::cout << "  -stress-rates <list>  Revalue at absolute rate shocks\n";
+    std::cout << "  -maturities <list>  Also price every strike at these maturities in one simulation\n";
+    std::cout << "  -strikes <list>     Strikes of the -maturities surface (default: K)\n";
+    std::cout << "  --profile       Report per-phase hot-path timings\n";
     std::cout << "  -h, --help      Show this help message\n";
 }
 
@@ -45,13 +78,38 @@ double parse_double(const char* arg, const char* param_name) {
 int parse_int(const char* arg, const char* param_name) {
     char* end;
     long value = std::strtol(arg, &end, 10);
-    if (*end != '\0' || value <= 0) {
+    if (*end != '\0' || value <= 0 || value > INT_MAX) {
         std::cerr << "Error: Invalid value for " << param_name << ": " << arg << std::endl;
         exit(1);
     }
     return static_cast<int>(value);
 }
 
+std::int64_t parse_int64(const char* arg, const char* param_name) {
+    char* end;
+    errno = 0;
+    long long value = std::strtoll(arg, &end, 10);
+    if (*end != '\0' || value <= 0 || errno == ERANGE) {
+        std::cerr << "Error: Invalid value for " << param_name << ": " << arg << std::endl;
+        exit(1);
+    }
+    return static_cast<std::int64_t>(value);
+}
+
+std::vector<double> parse_list(const char* arg, const char* param_name) {
+    std::vector<double> values;
+    std::stringstream stream(arg);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        values.push_back(parse_double(item.c_str(), param_name));
+    }
+    if (values.empty()) {
+        std::cerr << "Error: Invalid value for " << param_name << ": " << arg << std::endl;
+        exit(1);
+    }
+    return values;
+}
+
 // Timing utility class
 class Timer {
 private:
@@ -83,21 +141,268 @@ public:
     }
 };
 
+// Print per-thread cycle attribution for the instrumented pricing loop
+void print_profile_report(const ProfileReport& report) {
+    std::cout << std::endl;
+    std::cout << "Profile:" << std::endl;
+    std::cout << "========" << std::endl;
+    if (!report.enabled) {
+        std::cout << "  Profiling is not compiled in; rebuild with -DMC_ENABLE_PROFILING=ON" << std::endl;
+        return;
+    }
+    
+    const char* phase_names[] = {"RNG", "Step", "Payoff", "Reduction"};
+    const int n_phases = static_cast<int>(ProfilePhase::Count);
+    
+    std::cout << "  " << std::left << std::setw(8) << "Thread" << std::right;
+    for (int i = 0; i < n_phases; ++i) {
+        std::cout << std::setw(16) << phase_names[i];
+    }
+    std::cout << std::setw(12) << "Paths" << std::setw(14) << "Steps" << std::setw(12) << "Allocs" << std::endl;
+    
+    auto print_row = [&](const std::string& label, const ThreadProfile& profile) {
+        std::cout << "  " << std::left << std::setw(8) << label << std::right;
+        for (int i = 0; i < n_phases; ++i) {
+            std::cout << std::setw(16) << profile.cycles[i];
+        }
+        std::cout << std::setw(12) << profile.counts[static_cast<int>(ProfileCounter::Paths)]
+                  << std::setw(14) << profile.counts[static_cast<int>(ProfileCounter::Steps)]
+                  << std::setw(12) << profile.counts[static_cast<int>(ProfileCounter::Allocations)]
+                  << std::endl;
+    };
+    
+    for (std::size_t t = 0; t < report.threads.size(); ++t) {
+        print_row(std::to_string(report.thread_ids[t]), report.threads[t]);
+    }
+    ThreadProfile total = report.total();
+    print_row("Total", total);
+    
+    // Share of attributed cycles per phase
+    double all_cycles = 0.0;
+    for (int i = 0; i < n_phases; ++i) {
+        all_cycles += static_cast<double>(total.cycles[i]);
+    }
+    if (all_cycles > 0.0) {
+        std::cout << "  " << std::left << std::setw(8) << "Share" << std::right << std::fixed << std::setprecision(1);
+        for (int i = 0; i < n_phases; ++i) {
+            std::cout << std::setw(15) << 100.0 * total.cycles[i] / all_cycles << "%";
+        }
+        std::cout << std::endl;
+    }
+}
+
 // Function to run Monte Carlo simulation with timing
 std::pair<std::pair<MCResult, MCResult>, long long> run_monte_carlo_timed(
-    const GBMParams& gbm_params, double K, int n_paths, double r) {
+    PricingContext& context, const GBMParams& gbm_params, double K, double r,
+    const EngineOptions& engine) {
+    
+    Timer timer;
+    timer.start();
+    
+    MCResult mc_call_result = context.run(PricingPlan(gbm_params, r, PayoffSpec{K, true}, engine));
+    MCResult mc_put_result = context.run(PricingPlan(gbm_params, r, PayoffSpec{K, false}, engine));
+    
+    timer.stop();
+    
+    return std::make_pair(std::make_pair(mc_call_result, mc_put_result), timer.get_elapsed_ms());
+}
+
+// Settings of the chunked (checkpointed and/or progress-reporting) mode
+struct ChunkedSettings {
+    std::string checkpoint_file;     // Checkpoint prefix ("" disables checkpointing)
+    double checkpoint_every = 60.0;  // Seconds between checkpoints
+    bool resume = false;             // Continue from existing checkpoint files
+    bool progress = false;           // Stream NDJSON progress records to stderr
+    double progress_every = 1.0;     // Seconds between progress records
+    double deadline_ms = 0.0;        // Wall-time budget of the whole run (0 = none)
+};
+
+// Set by SIGINT; running chunked valuations stop at the next chunk boundary
+CancellationToken interrupt_token;
+
+void handle_interrupt(int) {
+    interrupt_token.cancel();
+}
+
+// Write one progress record as a single NDJSON line on stderr
+void print_progress(const char* option, const ProgressRecord& record) {
+    std::ostringstream line;
+    line << std::setprecision(10)
+         << "{\"option\":\"" << option << "\""
+         << ",\"paths_done\":" << record.paths_done
+         << ",\"n_paths\":" << record.n_paths
+         << ",\"price\":" << record.price
+         << ",\"stderr\":" << record.stderr
+         << ",\"paths_per_s\":" << record.paths_per_second
+         << ",\"elapsed_s\":" << record.elapsed_seconds
+         << ",\"eta_s\":" << record.eta_seconds << "}";
+    std::cerr << line.str() << std::endl;
+}
+
+// Run one option in chunks, with optional checkpoint/resume and progress;
+// paths_run receives the paths simulated by this call (resumed ones excluded)
+MCResult run_chunked(PricingContext& context, const PricingPlan& plan, const char* option,
+                     const ChunkedSettings& settings, std::chrono::steady_clock::time_point deadline,
+                     std::int64_t& paths_run) {
+    ChunkedRun run(plan);
+    if (!settings.checkpoint_file.empty()) {
+        std::string file = settings.checkpoint_file + "." + option;
+        if (settings.resume && run.resume(file)) {
+            std::cout << "  Resumed " << file << " at path " << run.next_path() << std::endl;
+        }
+        run.set_checkpoint(file, settings.checkpoint_every);
+    }
+    const std::int64_t first_path = run.next_path();
+    if (settings.progress) {
+        run.set_progress([option](const ProgressRecord& record) { print_progress(option, record); },
+                         settings.progress_every);
+    }
+
+    RunLimits limits;
+    limits.deadline = deadline;
+    limits.cancel = &interrupt_token;
+    BoundedResult result = run.run_until(context, limits);
+    if (result.reason != StopReason::Completed) {
+        std::cout << "  " << option << ": stopped "
+                  << (result.reason == StopReason::Deadline ? "at the deadline" : "by interrupt")
+                  << " after " << result.paths_completed << " of " << plan.options().n_paths
+                  << " paths" << std::endl;
+    }
+    paths_run = result.paths_completed - first_path;
+    return result.estimate;
+}
+
+// Function to run the chunked Monte Carlo simulation with timing; paths_run
+// receives the paths simulated for the call and the put together
+std::pair<std::pair<MCResult, MCResult>, long long> run_monte_carlo_chunked(
+    PricingContext& context, const GBMParams& gbm_params, double K, double r,
+    const EngineOptions& engine, const ChunkedSettings& settings, std::int64_t& paths_run) {
     
     Timer timer;
     timer.start();
     
-    MCResult mc_call_result = monte_carlo_price(gbm_params, K, true, n_paths, r);
-    MCResult mc_put_result = monte_carlo_price(gbm_params, K, false, n_paths, r);
+    // The call gets the first half of a deadline budget, the put the rest
+    using clock = std::chrono::steady_clock;
+    clock::time_point call_deadline = clock::time_point::max();
+    clock::time_point put_deadline = clock::time_point::max();
+    if (settings.deadline_ms > 0.0) {
+        clock::time_point now = clock::now();
+        auto budget = std::chrono::duration_cast<clock::duration>(
+            std::chrono::duration<double, std::milli>(settings.deadline_ms));
+        call_deadline = now + budget / 2;
+        put_deadline = now + budget;
+    }
+    
+    PricingPlan call_plan(gbm_params, r, PayoffSpec{K, true}, engine);
+    PricingPlan put_plan(gbm_params, r, PayoffSpec{K, false}, engine);
+    std::int64_t call_paths = 0;
+    std::int64_t put_paths = 0;
+    MCResult mc_call_result = run_chunked(context, call_plan, "call", settings, call_deadline, call_paths);
+    MCResult mc_put_result = run_chunked(context, put_plan, "put", settings, put_deadline, put_paths);
+    paths_run = call_paths + put_paths;
     
     timer.stop();
     
     return std::make_pair(std::make_pair(mc_call_result, mc_put_result), timer.get_elapsed_ms());
 }
 
+void print_mlmc(const char* option, const MLMCResult& result, double bs_price) {
+    std::cout << option << " Option (MLMC, Euler):" << std::endl;
+    std::cout << "  Estimate:      $" << std::fixed << std::setprecision(6) << result.price
+              << " ± " << result.stderr << " (bias ~" << result.bias
+              << (result.converged ? ")" : ", max levels reached)") << std::endl;
+    std::cout << "  Black-Scholes: $" << bs_price << std::endl;
+    std::cout << "  Level  Steps        Paths      Variance   Seconds" << std::endl;
+    for (std::size_t l = 0; l < result.levels.size(); ++l) {
+        const MLMCLevel& level = result.levels[l];
+        std::cout << "  " << std::setw(5) << l << std::setw(7) << level.steps
+                  << std::setw(13) << level.paths
+                  << std::setw(14) << std::scientific << std::setprecision(3) << level.variance
+                  << std::setw(10) << std::fixed << std::setprecision(3) << level.seconds << std::endl;
+    }
+    std::cout << "  Cost: " << std::scientific << std::setprecision(3) << result.cost
+              << " path steps (single-level MC: " << result.single_level_cost << ", "
+              << std::fixed << std::setprecision(1) << result.single_level_cost / result.cost
+              << "x more)" << std::endl;
+    std::cout << std::endl;
+}
+
+void print_sampling(const char* option, const char* scheme, const MCResult& result, double bs_price) {
+    std::cout << option << " Option (" << scheme << " sampling):" << std::endl;
+    std::cout << "  Estimate:      $" << std::fixed << std::setprecision(6) << result.price
+              << " ± " << result.stderr << std::endl;
+    std::cout << "  Black-Scholes: $" << bs_price << std::endl;
+    std::cout << std::endl;
+}
+
+void print_greeks(const char* option, const GreeksPoint& point, const BSGreeks* reference) {
+    std::cout << option << " Option Greeks (common random numbers):" << std::endl;
+    const std::pair<const char*, MCResult> rows[] = {
+        {"Delta", point.delta}, {"Gamma", point.gamma}, {"Vega", point.vega}, {"Theta", point.theta}};
+    const double exact[] = {reference ? reference->delta : 0.0, reference ? reference->gamma : 0.0,
+                            reference ? reference->vega : 0.0, reference ? reference->theta : 0.0};
+    for (int i = 0; i < 4; ++i) {
+        std::cout << "  " << std::left << std::setw(7) << rows[i].first << std::right << std::fixed
+                  << std::setprecision(6) << std::setw(12) << rows[i].second.price << " ± "
+                  << rows[i].second.stderr;
+        if (reference) {
+            std::cout << "  (Black-Scholes " << exact[i] << ")";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+void print_scenarios(const char* option, const ScenarioCube& cube) {
+    std::cout << option << " Option Scenarios (common random numbers):" << std::endl;
+    std::cout << "  " << std::setw(10) << "S0" << std::setw(10) << "sigma" << std::setw(10) << "r"
+              << std::setw(14) << "Price" << std::setw(12) << "Std Error" << std::endl;
+    for (std::size_t i = 0; i < cube.spots.size(); ++i) {
+        for (std::size_t j = 0; j < cube.vols.size(); ++j) {
+            for (std::size_t k = 0; k < cube.rates.size(); ++k) {
+                const MCResult& result = cube.at(i, j, k);
+                std::cout << "  " << std::fixed << std::setprecision(4) << std::setw(10) << cube.spots[i]
+                          << std::setw(10) << cube.vols[j] << std::setw(10) << cube.rates[k]
+                          << std::setprecision(6) << std::setw(14) << result.price << std::setw(12)
+                          << result.stderr << std::endl;
+            }
+        }
+    }
+    std::cout << std::endl;
+}
+
+void print_surface(const MaturitySurface& surface) {
+    std::cout << "Strike x Maturity Surface (one simulation):" << std::endl;
+    std::cout << "  " << std::setw(8) << "T" << std::setw(10) << "K" << std::setw(6) << ""
+              << std::setw(14) << "Price" << std::setw(12) << "Std Error" << std::endl;
+    for (std::size_t m = 0; m < surface.maturities.size(); ++m) {
+        for (std::size_t j = 0; j < surface.payoffs.size(); ++j) {
+            const MCResult& result = surface.at(m, j);
+            std::cout << "  " << std::fixed << std::setprecision(4) << std::setw(8) << surface.maturities[m]
+                      << std::setw(10) << surface.payoffs[j].K << std::setw(6)
+                      << (surface.payoffs[j].call ? "call" : "put") << std::setprecision(6) << std::setw(14)
+                      << result.price << std::setw(12) << result.stderr << std::endl;
+        }
+    }
+    std::cout << std::endl;
+}
+
+void print_importance(const char* option, const ImportanceSamplingReport& report, double bs_price) {
+    std::cout << option << " Option (importance sampling, shift " << std::fixed << std::setprecision(4)
+              << report.shift << "):" << std::endl;
+    std::cout << "  Shifted:       $" << std::setprecision(6) << report.shifted.price
+              << " ± " << report.shifted.stderr << std::endl;
+    std::cout << "  Plain:         $" << report.plain.price << " ± " << report.plain.stderr << std::endl;
+    std::cout << "  Black-Scholes: $" << bs_price << std::endl;
+    if (std::isnan(report.variance_reduction)) {
+        std::cout << "  Variance reduction: n/a (no sampling error)" << std::endl;
+    } else {
+        std::cout << "  Variance reduction: " << std::setprecision(1) << report.variance_reduction
+                  << "x" << std::endl;
+    }
+    std::cout << std::endl;
+}
+
 int main(int argc, char* argv[]) {
     // Default parameters
     double S0 = 100.0;      // Initial stock price
@@ -107,7 +412,21 @@ int main(int argc, char* argv[]) {
     double sigma = 0.2;      // Volatility
     double T = 1.0;          // Time to maturity
     int steps = 252;         // Number of time steps
-    int n_paths = 1000000;   // Number of Monte Carlo paths
+    std::int64_t n_paths = 1000000; // Number of Monte Carlo paths
+    bool profile = false;    // Print a per-phase profile of the pricing loop
+    bool seeded = false;     // Whether -seed was given
+    std::uint64_t seed = 0;  // Seed of the random streams
+    ChunkedSettings chunked; // Checkpoint and progress settings
+    double mlmc_rmse = 0.0;  // Target RMSE of the MLMC comparison (0: off)
+    bool importance = false; // Report importance sampling against plain MC
+    std::string sampling;    // Stratified or Latin hypercube comparison (empty: off)
+    bool moment_matching = false;        // Match the terminal driver per batch
+    bool martingale_correction = false;  // Reprice the forward per batch
+    bool greeks = false;     // Report bump-and-revalue Greeks
+    bool stress = false;     // Revalue on a scenario grid
+    ScenarioGrid grid;       // Stress shocks (unset axes stay unshocked)
+    std::vector<double> maturities;  // Surface maturities (empty: off)
+    std::vector<double> strikes;     // Surface strikes (empty: K)
     
     // Parse command-line arguments
     for (int i = 1; i < argc; ++i) {
@@ -139,7 +458,76 @@ int main(int argc, char* argv[]) {
             steps = parse_int(argv[++i], "steps");
         }
         else if (arg == "-paths" && i + 1 < argc) {
-            n_paths = parse_int(argv[++i], "paths");
+            n_paths = parse_int64(argv[++i], "paths");
+        }
+        else if (arg == "-seed" && i + 1 < argc) {
+            seed = static_cast<std::uint64_t>(parse_int64(argv[++i], "seed"));
+            seeded = true;
+        }
+        else if (arg == "-checkpoint" && i + 1 < argc) {
+            chunked.checkpoint_file = argv[++i];
+        }
+        else if (arg == "-checkpoint-every" && i + 1 < argc) {
+            chunked.checkpoint_every = parse_double(argv[++i], "checkpoint-every");
+        }
+        else if (arg == "--resume") {
+            chunked.resume = true;
+        }
+        else if (arg == "--progress") {
+            chunked.progress = true;
+        }
+        else if (arg == "-progress-every" && i + 1 < argc) {
+            chunked.progress_every = parse_double(argv[++i], "progress-every");
+        }
+        else if (arg == "-deadline-ms" && i + 1 < argc) {
+            chunked.deadline_ms = parse_double(argv[++i], "deadline-ms");
+        }
+        else if (arg == "-mlmc" && i + 1 < argc) {
+            mlmc_rmse = parse_double(argv[++i], "mlmc");
+            if (mlmc_rmse <= 0.0) {
+                std::cerr << "Error: -mlmc needs a positive RMSE" << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "--importance") {
+            importance = true;
+        }
+        else if (arg == "--moment-matching") {
+            moment_matching = true;
+        }
+        else if (arg == "--martingale") {
+            martingale_correction = true;
+        }
+        else if (arg == "--greeks") {
+            greeks = true;
+        }
+        else if (arg == "-stress-spots" && i + 1 < argc) {
+            grid.spot_shocks = parse_list(argv[++i], "stress-spots");
+            stress = true;
+        }
+        else if (arg == "-stress-vols" && i + 1 < argc) {
+            grid.vol_shocks = parse_list(argv[++i], "stress-vols");
+            stress = true;
+        }
+        else if (arg == "-stress-rates" && i + 1 < argc) {
+            grid.rate_shocks = parse_list(argv[++i], "stress-rates");
+            stress = true;
+        }
+        else if (arg == "-maturities" && i + 1 < argc) {
+            maturities = parse_list(argv[++i], "maturities");
+        }
+        else if (arg == "-strikes" && i + 1 < argc) {
+            strikes = parse_list(argv[++i], "strikes");
+        }
+        else if (arg == "-sampling" && i + 1 < argc) {
+            sampling = argv[++i];
+            if (sampling != "stratified" && sampling != "lhs") {
+                std::cerr << "Error: -sampling must be stratified or lhs" << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "--profile") {
+            profile = true;
         }
         else {
             std::cerr << "Error: Unknown argument " << arg << std::endl;
@@ -153,6 +541,19 @@ int main(int argc, char* argv[]) {
         std::cerr << "Error: All parameters must be positive" << std::endl;
         return 1;
     }
+    if ((!chunked.checkpoint_file.empty() || chunked.resume) && !seeded) {
+        std::cerr << "Error: -checkpoint and --resume need an explicit -seed" << std::endl;
+        return 1;
+    }
+    if (chunked.resume && chunked.checkpoint_file.empty()) {
+        std::cerr << "Error: --resume needs -checkpoint <file>" << std::endl;
+        return 1;
+    }
+    if ((moment_matching || martingale_correction) && n_paths < 2 * kCorrectionBatchPaths) {
+        std::cerr << "Error: --moment-matching and --martingale need -paths of at least "
+                  << 2 * kCorrectionBatchPaths << std::endl;
+        return 1;
+    }
     
     std::cout << "Monte Carlo Option Pricing Simulator" << std::endl;
     std::cout << "====================================" << std::endl;
@@ -170,13 +571,22 @@ int main(int argc, char* argv[]) {
     std::cout << "  Monte Carlo Paths:        " << n_paths << std::endl;
     std::cout << std::endl;
     
-    // Unit test: Print 5 samples from randn()
+    // Default thread budget; nothing below touches the global OpenMP state
+    PricingContext context;
+    if (!seeded) {
+        seed = context.next_seed();
+    }
+    EngineOptions engine{n_paths, seed};
+    engine.moment_matching = moment_matching;
+    engine.martingale_correction = martingale_correction;
+    
+    // Unit test: Print 5 samples from the context's random stream
     std::cout << "Unit Test - Random Normal Samples:" << std::endl;
-    std::cout << "  Sample 1: " << std::fixed << std::setprecision(6) << randn() << std::endl;
-    std::cout << "  Sample 2: " << std::fixed << std::setprecision(6) << randn() << std::endl;
-    std::cout << "  Sample 3: " << std::fixed << std::setprecision(6) << randn() << std::endl;
-    std::cout << "  Sample 4: " << std::fixed << std::setprecision(6) << randn() << std::endl;
-    std::cout << "  Sample 5: " << std::fixed << std::setprecision(6) << randn() << std::endl;
+    std::cout << "  Sample 1: " << std::fixed << std::setprecision(6) << context.rng().normal() << std::endl;
+    std::cout << "  Sample 2: " << std::fixed << std::setprecision(6) << context.rng().normal() << std::endl;
+    std::cout << "  Sample 3: " << std::fixed << std::setprecision(6) << context.rng().normal() << std::endl;
+    std::cout << "  Sample 4: " << std::fixed << std::setprecision(6) << context.rng().normal() << std::endl;
+    std::cout << "  Sample 5: " << std::fixed << std::setprecision(6) << context.rng().normal() << std::endl;
     std::cout << std::endl;
     
     // Create GBM parameters
@@ -191,44 +601,74 @@ int main(int argc, char* argv[]) {
     
     MCResult mc_call_result, mc_put_result;
     long long runtime_ms;
-    
+    // Paths per option behind runtime_ms; fewer than n_paths when a chunked
+    // run resumed or stopped early
+    double timed_paths = static_cast<double>(n_paths);
+    ProfileReport profile_report;
+    
+    if (!chunked.checkpoint_file.empty() || chunked.progress || chunked.deadline_ms > 0.0) {
+        std::signal(SIGINT, handle_interrupt);
+        // A long chunked run is not repeated single-threaded
+        if (!chunked.checkpoint_file.empty()) {
+            std::cout << "  Checkpointing to " << chunked.checkpoint_file << ".{call,put} every "
+                      << std::setprecision(1) << chunked.checkpoint_every << " s" << std::endl;
+        }
+        profiler_reset();
+        std::pair<std::pair<MCResult, MCResult>, long long> result;
+        std::int64_t paths_run = 0;
+        try {
+            result = run_monte_carlo_chunked(context, gbm_params, K, r, engine, chunked, paths_run);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+        timed_paths = paths_run / 2.0;
+        profile_report = profiler_snapshot();
+        mc_call_result = result.first.first;
+        mc_put_result = result.first.second;
+        runtime_ms = result.second;
+        
+        std::cout << "  Runtime: " << runtime_ms << " ms" << std::endl;
+    } else {
 #ifdef _OPENMP
-    // Get number of threads for display
-    int num_threads = omp_get_max_threads();
-    std::cout << "  OpenMP enabled with " << num_threads << " threads" << std::endl;
+        // Get number of threads for display
+        int num_threads = context.threads();
+        std::cout << "  OpenMP enabled with " << num_threads << " threads" << std::endl;
     
-    // Run multi-threaded version
-    auto result = run_monte_carlo_timed(gbm_params, K, n_paths, r);
-    mc_call_result = result.first.first;
-    mc_put_result = result.first.second;
-    runtime_ms = result.second;
+        // Run multi-threaded version
+        profiler_reset();
+        auto result = run_monte_carlo_timed(context, gbm_params, K, r, engine);
+        profile_report = profiler_snapshot();
+        mc_call_result = result.first.first;
+        mc_put_result = result.first.second;
+        runtime_ms = result.second;
     
-    std::cout << "  Multi-threaded Runtime: " << runtime_ms << " ms" << std::endl;
+        std::cout << "  Multi-threaded Runtime: " << runtime_ms << " ms" << std::endl;
     
-    // Run single-threaded version for comparison
-    std::cout << "  Running single-threaded version for comparison..." << std::endl;
-    omp_set_num_threads(1);
+        // Run single-threaded version for comparison
+        std::cout << "  Running single-threaded version for comparison..." << std::endl;
+        PricingContext single_context(1);
     
-    auto single_result = run_monte_carlo_timed(gbm_params, K, n_paths, r);
-    long long single_runtime_ms = single_result.second;
+        auto single_result = run_monte_carlo_timed(single_context, gbm_params, K, r, engine);
+        long long single_runtime_ms = single_result.second;
     
-    std::cout << "  Single-threaded Runtime: " << single_runtime_ms << " ms" << std::endl;
+        std::cout << "  Single-threaded Runtime: " << single_runtime_ms << " ms" << std::endl;
     
-    // Calculate speedup
-    double speedup = static_cast<double>(single_runtime_ms) / runtime_ms;
-    std::cout << "  Speedup: " << std::fixed << std::setprecision(2) << speedup << "x" << std::endl;
-    
-    // Restore original thread count
-    omp_set_num_threads(num_threads);
+        // Calculate speedup
+        double speedup = static_cast<double>(single_runtime_ms) / runtime_ms;
+        std::cout << "  Speedup: " << std::fixed << std::setprecision(2) << speedup << "x" << std::endl;
 #else
-    // Run single-threaded version (no OpenMP)
-    auto result = run_monte_carlo_timed(gbm_params, K, n_paths, r);
-    mc_call_result = result.first.first;
-    mc_put_result = result.first.second;
-    runtime_ms = result.second;
-    
-    std::cout << "  Single-threaded Runtime: " << runtime_ms << " ms" << std::endl;
+        // Run single-threaded version (no OpenMP)
+        profiler_reset();
+        auto result = run_monte_carlo_timed(context, gbm_params, K, r, engine);
+        profile_report = profiler_snapshot();
+        mc_call_result = result.first.first;
+        mc_put_result = result.first.second;
+        runtime_ms = result.second;
+    
+        std::cout << "  Single-threaded Runtime: " << runtime_ms << " ms" << std::endl;
 #endif
+    }
     
     // Calculate relative errors
     double call_error = std::abs(mc_call_result.price - bs_call_price) / bs_call_price * 100.0;
@@ -257,7 +697,96 @@ int main(int argc, char* argv[]) {
     std::cout << "Performance:" << std::endl;
     std::cout << "  Runtime: " << runtime_ms << " ms" << std::endl;
     std::cout << "  Paths per second: " << std::fixed << std::setprecision(0) 
-              << (n_paths * 1000.0 / runtime_ms) << std::endl;
+              << (timed_paths * 1000.0 / runtime_ms) << std::endl;
+    std::cout << std::endl;
+    
+    if (mlmc_rmse > 0.0) {
+        MLMCOptions options{mlmc_rmse, seed};
+        MLMCResult mlmc_call = mlmc_price(context, gbm_params, r, PayoffSpec{K, true},
+                                          MLMCProduct::European, options);
+        MLMCResult mlmc_put = mlmc_price(context, gbm_params, r, PayoffSpec{K, false},
+                                         MLMCProduct::European, options);
+        print_mlmc("Call", mlmc_call, bs_call_price);
+        print_mlmc("Put", mlmc_put, bs_put_price);
+    }
+    
+    if (importance) {
+        print_importance("Call", importance_sampling_report(context, gbm_params, r, PayoffSpec{K, true},
+                                                            n_paths, seed), bs_call_price);
+        print_importance("Put", importance_sampling_report(context, gbm_params, r, PayoffSpec{K, false},
+                                                           n_paths, seed), bs_put_price);
+    }
+    
+    if (!sampling.empty()) {
+        SamplingOptions options;
+        if (sampling == "lhs") {
+            options.scheme = SamplingScheme::LatinHypercube;
+        }
+        try {
+            EngineOptions plain{n_paths, seed};
+            print_sampling("Call", sampling.c_str(),
+                           stratified_run(context, PricingPlan(gbm_params, r, PayoffSpec{K, true}, plain), options),
+                           bs_call_price);
+            print_sampling("Put", sampling.c_str(),
+                           stratified_run(context, PricingPlan(gbm_params, r, PayoffSpec{K, false}, plain), options),
+                           bs_put_price);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    
+    if (greeks) {
+        try {
+            EngineOptions plain{n_paths, seed};
+            for (bool call : {true, false}) {
+                PricingPlan plan(gbm_params, r, PayoffSpec{K, call}, plain);
+                GreeksReport report = bump_and_revalue(context, plan, GreeksOptions());
+                BSGreeks reference{};
+                if (sigma > 0.0) {
+                    reference = bs_greeks(S0, K, r, sigma, T, call);
+                }
+                print_greeks(call ? "Call" : "Put", report.base, sigma > 0.0 ? &reference : nullptr);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    
+    if (stress) {
+        try {
+            EngineOptions plain{n_paths, seed};
+            for (bool call : {true, false}) {
+                PricingPlan plan(gbm_params, r, PayoffSpec{K, call}, plain);
+                print_scenarios(call ? "Call" : "Put", revalue_scenarios(context, plan, grid));
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    
+    if (!maturities.empty()) {
+        if (strikes.empty()) {
+            strikes.push_back(K);
+        }
+        std::vector<PayoffSpec> payoffs;
+        for (double strike : strikes) {
+            payoffs.push_back(PayoffSpec{strike, true});
+            payoffs.push_back(PayoffSpec{strike, false});
+        }
+        try {
+            print_surface(price_surface(context, gbm_params, r, maturities, payoffs, EngineOptions{n_paths, seed}));
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    
+    if (profile) {
+        print_profile_report(profile_report);
+    }
     
     return 0;
 }
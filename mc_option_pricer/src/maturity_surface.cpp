@@ -0,0 +1,155 @@
+#include "maturity_surface.hpp"
+#include "payoffs.hpp"
+#include "profiler.hpp"
+#include "random_utils.hpp"
+#include "reduction_tree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+// Simulation grid: one normal per interval, observations at interval ends
+struct Grid {
+    std::vector<double> drift;           // (r - sigma^2 / 2) dt of each interval
+    std::vector<double> vol;             // sigma sqrt(dt) of each interval
+    std::vector<std::size_t> slot_end;   // Intervals stepped before each observation slot
+    std::vector<std::size_t> slot;       // Observation slot of each maturity
+};
+
+Grid make_grid(const GBMParams& params, double r, const std::vector<double>& maturities) {
+    std::vector<std::size_t> order(maturities.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&](std::size_t a, std::size_t b) { return maturities[a] < maturities[b]; });
+
+    // Times within this distance of a grid point are observed at the point
+    const double dt = params.T / params.steps;
+    const double tolerance = 1e-9 * dt;
+    const double drift_rate = r - 0.5 * params.sigma * params.sigma;
+
+    Grid grid;
+    grid.slot.resize(maturities.size());
+    auto add_interval = [&](double length) {
+        grid.drift.push_back(drift_rate * length);
+        grid.vol.push_back(params.sigma * std::sqrt(length));
+    };
+    auto observe = [&](std::size_t m) {
+        if (grid.slot_end.empty() || grid.slot_end.back() != grid.drift.size()) {
+            grid.slot_end.push_back(grid.drift.size());
+        }
+        grid.slot[m] = grid.slot_end.size() - 1;
+    };
+
+    std::size_t next = 0;
+    for (int k = 1; k <= params.steps && next < order.size(); ++k) {
+        const double left = (k - 1) * dt;
+        const double right = k == params.steps ? params.T : k * dt;
+        double previous = left;
+        // Insert the times strictly inside the step as extra grid points
+        while (next < order.size() && maturities[order[next]] < right - tolerance) {
+            add_interval(maturities[order[next]] - previous);
+            previous = maturities[order[next]];
+            observe(order[next++]);
+        }
+        if (next == order.size()) {
+            break;
+        }
+        // An unsplit step keeps the uniform dt of PricingPlan
+        add_interval(previous == left ? dt : right - previous);
+        while (next < order.size() && maturities[order[next]] <= right + tolerance) {
+            observe(order[next++]);
+        }
+    }
+    return grid;
+}
+
+} // namespace
+
+MaturitySurface price_surface(PricingContext& context, const GBMParams& params, double r,
+                              const std::vector<double>& maturities, const std::vector<PayoffSpec>& payoffs,
+                              const EngineOptions& engine) {
+    if (maturities.empty() || payoffs.empty()) {
+        throw std::invalid_argument("Surface needs at least one maturity and one payoff");
+    }
+    // The plan validates the model, the rate and the paths
+    const PricingPlan plan(params, r, payoffs.front(), engine);
+    for (const PayoffSpec& payoff : payoffs) {
+        if (payoff.K <= 0.0) {
+            throw std::invalid_argument("Strike price K must be positive");
+        }
+    }
+    for (double t : maturities) {
+        if (!(t > 0.0 && t <= params.T)) {
+            throw std::invalid_argument("Maturities must lie in (0, T]");
+        }
+    }
+    if (engine.drift_shift != 0.0 || engine.moment_matching || engine.martingale_correction) {
+        throw std::invalid_argument("Maturity surface does not support drift shift or batch corrections");
+    }
+
+    const Grid grid = make_grid(params, r, maturities);
+    const std::size_t n_intervals = grid.drift.size();
+    const std::size_t n_slots = grid.slot_end.size();
+    const std::size_t n_maturities = maturities.size();
+    const std::size_t n_payoffs = payoffs.size();
+    const std::size_t n_points = n_maturities * n_payoffs;
+
+    std::vector<double> discounts;
+    for (double t : maturities) {
+        discounts.push_back(std::exp(-r * t));
+    }
+
+    // log S of a leaf's paths at each slot, slot-major, one leaf per thread
+    std::vector<std::vector<double>> scratch(static_cast<std::size_t>(context.threads()),
+                                             std::vector<double>(n_slots * kReductionLeafPaths));
+
+    auto leaf_fn = [&](const LeafTask& task, PathStats* sums) {
+#ifdef _OPENMP
+        std::vector<double>& observed = scratch[static_cast<std::size_t>(omp_get_thread_num())];
+#else
+        std::vector<double>& observed = scratch[0];
+#endif
+        {
+            MC_PROFILE_SCOPE(Step);
+            for (int k = 0; k < task.count; ++k) {
+                RngStream rng(engine.seed, static_cast<std::uint64_t>(task.first + k));
+                double log_price = 0.0;
+                std::size_t slot = 0;
+                for (std::size_t j = 0; j < n_intervals; ++j) {
+                    log_price += grid.drift[j] + grid.vol[j] * rng.normal();
+                    if (j + 1 == grid.slot_end[slot]) {
+                        observed[slot * kReductionLeafPaths + k] = log_price;
+                        ++slot;
+                    }
+                }
+            }
+        }
+
+        MC_PROFILE_SCOPE(Payoff);
+        for (std::size_t m = 0; m < n_maturities; ++m) {
+            const double* x = &observed[grid.slot[m] * kReductionLeafPaths];
+            for (std::size_t j = 0; j < n_payoffs; ++j) {
+                const PayoffSpec& payoff = payoffs[j];
+                PathStats& stats = sums[m * n_payoffs + j];
+                for (int k = 0; k < task.count; ++k) {
+                    double S_T = params.S0 * std::exp(x[k]);
+                    double value = payoff.call ? european_call(S_T, payoff.K) : european_put(S_T, payoff.K);
+                    stats.add(discounts[m] * value);
+                }
+            }
+        }
+        MC_PROFILE_COUNT(Paths, task.count);
+    };
+
+    MaturitySurface surface{maturities, payoffs, {}};
+    for (const PathStats& total : reduce_leaves(context.threads(), engine.n_paths, n_points, leaf_fn)) {
+        surface.prices.push_back(plan.finish(total));
+    }
+    return surface;
+}
@@ -0,0 +1,189 @@
+#include "mcpricer.h"
+#include "black_scholes.hpp"
+#include "pricing_context.hpp"
+#include <cmath>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+// Every entry point converts C++ exceptions into status codes; nothing may
+// propagate across the C boundary.
+
+struct mcp_context {
+    explicit mcp_context(int threads, std::uint64_t seed) : context(threads, seed) {}
+
+    PricingContext context;
+    std::string last_error;
+};
+
+namespace {
+
+const double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+mcp_status fail(mcp_context* context, mcp_status status, const char* message) {
+    if (context) {
+        context->last_error = message;
+    }
+    return status;
+}
+
+// Run f, translating exceptions into a status and the context's last error
+template <typename F>
+mcp_status guarded(mcp_context* context, F f) {
+    try {
+        return f();
+    } catch (const std::invalid_argument& e) {
+        return fail(context, MCP_INVALID_ARGUMENT, e.what());
+    } catch (const std::bad_alloc&) {
+        return fail(context, MCP_OUT_OF_MEMORY, "Out of memory");
+    } catch (const std::exception& e) {
+        return fail(context, MCP_INTERNAL_ERROR, e.what());
+    } catch (...) {
+        return fail(context, MCP_INTERNAL_ERROR, "Unknown error");
+    }
+}
+
+void check_finite(double S0, double K, double r, double sigma, double T) {
+    if (!std::isfinite(S0) || !std::isfinite(K) || !std::isfinite(r) ||
+        !std::isfinite(sigma) || !std::isfinite(T)) {
+        throw std::invalid_argument("Option inputs must be finite");
+    }
+}
+
+MCResult price_one(PricingContext& context, double S0, double K, double r, double sigma, double T,
+                   std::int32_t steps, std::int64_t n_paths, std::int32_t is_call,
+                   std::uint64_t seed) {
+    check_finite(S0, K, r, sigma, T);
+    GBMParams params = {S0, sigma, T, steps};
+    PricingPlan plan(params, r, PayoffSpec{K, is_call != 0},
+                     EngineOptions{n_paths, seed});
+    return context.run(plan);
+}
+
+} // namespace
+
+extern "C" {
+
+uint32_t mcp_abi_version(void) {
+    return MCPRICER_ABI_VERSION;
+}
+
+const char* mcp_status_string(mcp_status status) {
+    switch (status) {
+        case MCP_OK: return "ok";
+        case MCP_INVALID_ARGUMENT: return "invalid argument";
+        case MCP_NULL_POINTER: return "null pointer";
+        case MCP_OUT_OF_MEMORY: return "out of memory";
+        case MCP_INTERNAL_ERROR: return "internal error";
+    }
+    return "unknown status";
+}
+
+mcp_status mcp_context_create(int32_t threads, uint64_t seed, mcp_context** out) {
+    if (!out) {
+        return MCP_NULL_POINTER;
+    }
+    *out = nullptr;
+    return guarded(nullptr, [&]() {
+        *out = new mcp_context(threads, seed);
+        return MCP_OK;
+    });
+}
+
+void mcp_context_destroy(mcp_context* context) {
+    delete context;
+}
+
+int32_t mcp_context_threads(const mcp_context* context) {
+    return context ? context->context.threads() : 0;
+}
+
+const char* mcp_context_last_error(const mcp_context* context) {
+    return context ? context->last_error.c_str() : "";
+}
+
+mcp_status mcp_price_european(mcp_context* context, double S0, double K, double r, double sigma,
+                              double T, int32_t steps, int64_t n_paths, int32_t is_call,
+                              uint64_t seed, double* price, double* std_error) {
+    if (!context) {
+        return MCP_NULL_POINTER;
+    }
+    if (!price || !std_error) {
+        return fail(context, MCP_NULL_POINTER, "Output pointer is NULL");
+    }
+    *price = kNaN;
+    *std_error = kNaN;
+    return guarded(context, [&]() {
+        MCResult result = price_one(context->context, S0, K, r, sigma, T, steps, n_paths, is_call, seed);
+        *price = result.price;
+        *std_error = result.stderr;
+        return MCP_OK;
+    });
+}
+
+mcp_status mcp_price_european_batch(mcp_context* context, size_t n, const double* S0,
+                                    const double* K, const double* r, const double* sigma,
+                                    const double* T, const int32_t* steps, const int64_t* n_paths,
+                                    const int32_t* is_call, const uint64_t* seeds, double* price,
+                                    double* std_error, int32_t* status) {
+    if (!context) {
+        return MCP_NULL_POINTER;
+    }
+    if (n > 0 && (!S0 || !K || !r || !sigma || !T || !steps || !n_paths || !is_call || !price)) {
+        return fail(context, MCP_NULL_POINTER, "Input or output array is NULL");
+    }
+
+    mcp_status first_failure = MCP_OK;
+    for (size_t i = 0; i < n; ++i) {
+        MCResult result = {kNaN, kNaN};
+        mcp_status option_status = guarded(context, [&]() {
+            std::uint64_t seed = seeds ? seeds[i] : context->context.next_seed();
+            result = price_one(context->context, S0[i], K[i], r[i], sigma[i], T[i], steps[i],
+                               n_paths[i], is_call[i], seed);
+            return MCP_OK;
+        });
+
+        price[i] = result.price;
+        if (std_error) {
+            std_error[i] = result.stderr;
+        }
+        if (status) {
+            status[i] = option_status;
+        }
+        if (first_failure == MCP_OK) {
+            first_failure = option_status;
+        }
+    }
+    return first_failure;
+}
+
+mcp_status mcp_black_scholes_batch(size_t n, const double* S0, const double* K, const double* r,
+                                   const double* sigma, const double* T, const int32_t* is_call,
+                                   double* price, int32_t* status) {
+    if (n > 0 && (!S0 || !K || !r || !sigma || !T || !is_call || !price)) {
+        return MCP_NULL_POINTER;
+    }
+
+    mcp_status first_failure = MCP_OK;
+    for (size_t i = 0; i < n; ++i) {
+        double value = kNaN;
+        mcp_status option_status = guarded(nullptr, [&]() {
+            check_finite(S0[i], K[i], r[i], sigma[i], T[i]);
+            value = is_call[i] ? bs_call(S0[i], K[i], r[i], sigma[i], T[i])
+                               : bs_put(S0[i], K[i], r[i], sigma[i], T[i]);
+            return MCP_OK;
+        });
+
+        price[i] = value;
+        if (status) {
+            status[i] = option_status;
+        }
+        if (first_failure == MCP_OK) {
+            first_failure = option_status;
+        }
+    }
+    return first_failure;
+}
+
+} // extern "C"
@@ -0,0 +1,189 @@
+#include "mixed_precision.hpp"
+#include "black_scholes.hpp"
+#include "payoffs.hpp"
+#include "pricing_plan.hpp"
+#include "random_utils.hpp"
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+// Plain float64 running sum
+struct PlainSum {
+    double sum = 0.0;
+    void add(double value) { sum += value; }
+    void merge(const PlainSum& other) { sum += other.sum; }
+    double value() const { return sum; }
+};
+
+// Neumaier compensated sum: tracks the low-order bits lost by each addition
+struct CompensatedSum {
+    double sum = 0.0;
+    double compensation = 0.0;
+    void add(double value) {
+        double t = sum + value;
+        if (std::abs(sum) >= std::abs(value)) {
+            compensation += (sum - t) + value;
+        } else {
+            compensation += (value - t) + sum;
+        }
+        sum = t;
+    }
+    void merge(const CompensatedSum& other) {
+        add(other.sum);
+        compensation += other.compensation;
+    }
+    double value() const { return sum + compensation; }
+};
+
+template <bool Compensated>
+struct AccumulatorFor {
+    using type = PlainSum;
+};
+
+template <>
+struct AccumulatorFor<true> {
+    using type = CompensatedSum;
+};
+
+double elapsed_seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+template <typename Policy>
+MCResult monte_carlo_price_policy(const GBMParams& p, double K, bool call, std::int64_t n_paths,
+                                  double r, std::uint64_t seed) {
+    using path_type = typename Policy::path_type;
+    using Accumulator = typename AccumulatorFor<Policy::compensated>::type;
+
+    // Validate up front: nothing below may throw inside the parallel region
+    if (p.S0 <= 0.0) {
+        throw std::invalid_argument("Initial stock price S0 must be positive");
+    }
+    if (p.sigma < 0.0) {
+        throw std::invalid_argument("Volatility sigma must be non-negative");
+    }
+    if (p.T <= 0.0) {
+        throw std::invalid_argument("Time to maturity T must be positive");
+    }
+    if (p.steps <= 0) {
+        throw std::invalid_argument("Number of steps must be positive");
+    }
+    if (K <= 0.0) {
+        throw std::invalid_argument("Strike price K must be positive");
+    }
+    if (n_paths <= 0) {
+        throw std::invalid_argument("Number of paths must be positive");
+    }
+    if (r < 0.0) {
+        throw std::invalid_argument("Risk-free rate r must be non-negative");
+    }
+
+    // Per-step log increments, folded once in double then narrowed to the path type
+    double dt = p.T / p.steps;
+    const path_type drift = static_cast<path_type>((r - 0.5 * p.sigma * p.sigma) * dt);
+    const path_type vol_sqrt_dt = static_cast<path_type>(p.sigma * std::sqrt(dt));
+    const double discount_factor = std::exp(-r * p.T);
+
+    // Per-thread partial sums, merged in thread order afterwards
+    struct Partial {
+        Accumulator total;
+        Accumulator squared;
+    };
+#ifdef _OPENMP
+    const int n_threads = omp_get_max_threads();
+#else
+    const int n_threads = 1;
+#endif
+    std::vector<Partial> partials(static_cast<std::size_t>(n_threads));
+
+#ifdef _OPENMP
+    #pragma omp parallel num_threads(n_threads)
+#endif
+    {
+#ifdef _OPENMP
+        Partial& local = partials[omp_get_thread_num()];
+#else
+        Partial& local = partials[0];
+#endif
+
+#ifdef _OPENMP
+        #pragma omp for schedule(static) nowait
+#endif
+        for (std::int64_t i = 0; i < n_paths; ++i) {
+            RngStream rng(seed, static_cast<std::uint64_t>(i));
+
+            // Evolve the log price in the policy's path precision
+            path_type log_price = 0;
+            for (int step = 0; step < p.steps; ++step) {
+                path_type Z = Policy::normal(rng);
+                log_price += drift + vol_sqrt_dt * Z;
+            }
+
+            // Payoff and accumulation always run in double
+            double S_T = p.S0 * std::exp(static_cast<double>(log_price));
+            double payoff = call ? european_call(S_T, K) : european_put(S_T, K);
+            double discounted_payoff = discount_factor * payoff;
+            local.total.add(discounted_payoff);
+            local.squared.add(discounted_payoff * discounted_payoff);
+        }
+    }
+
+    Accumulator total;
+    Accumulator total_squared;
+    for (const Partial& partial : partials) {
+        total.merge(partial.total);
+        total_squared.merge(partial.squared);
+    }
+
+    PathStats stats;
+    stats.count = n_paths;
+    stats.samples = n_paths;
+    stats.sum = total.value();
+    stats.sum_sq = total_squared.value();
+    return estimate_price(stats);
+}
+
+template MCResult monte_carlo_price_policy<DoublePrecision>(
+    const GBMParams&, double, bool, std::int64_t, double, std::uint64_t);
+template MCResult monte_carlo_price_policy<MixedPrecision>(
+    const GBMParams&, double, bool, std::int64_t, double, std::uint64_t);
+template MCResult monte_carlo_price_policy<CompensatedMixedPrecision>(
+    const GBMParams&, double, bool, std::int64_t, double, std::uint64_t);
+
+std::vector<PrecisionReportRow> precision_accuracy_report(const GBMParams& p, double r,
+                                                          const std::vector<double>& strikes,
+                                                          std::int64_t n_paths, std::uint64_t seed) {
+    std::vector<PrecisionReportRow> rows;
+    for (double K : strikes) {
+        for (bool call : {true, false}) {
+            PrecisionReportRow row;
+            row.K = K;
+            row.call = call;
+            row.bs_price = call ? bs_call(p.S0, K, r, p.sigma, p.T)
+                                : bs_put(p.S0, K, r, p.sigma, p.T);
+
+            auto start = std::chrono::steady_clock::now();
+            MCResult reference = monte_carlo_price_policy<DoublePrecision>(p, K, call, n_paths, r, seed);
+            row.double_seconds = elapsed_seconds(start);
+
+            start = std::chrono::steady_clock::now();
+            MCResult mixed = monte_carlo_price_policy<MixedPrecision>(p, K, call, n_paths, r, seed);
+            row.mixed_seconds = elapsed_seconds(start);
+
+            row.double_price = reference.price;
+            row.mixed_price = mixed.price;
+            row.stderr = reference.stderr;
+            row.mixed_stderr = mixed.stderr;
+            rows.push_back(row);
+        }
+    }
+    return rows;
+}
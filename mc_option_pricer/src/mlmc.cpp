@@ -0,0 +1,246 @@
+#include "mlmc.hpp"
+#include "payoffs.hpp"
+#include "random_utils.hpp"
+#include "reduction_tree.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Sample i of level l uses stream (l + 1) * 2^48 + i
+const int kLevelStreamShift = 48;
+
+// Another batch is simulated while some level misses more than this
+// fraction of its optimal sample count
+const double kAllocationTolerance = 0.01;
+
+struct Setup {
+    double S0;
+    double sigma;
+    double T;
+    double r;
+    double discount;
+    PayoffSpec payoff;
+    MLMCProduct product;
+    int base_steps;
+    int refinement;
+    std::uint64_t seed;
+};
+
+// Discounted payoff and correction of one sample
+struct Sample {
+    double fine;
+    double diff;
+};
+
+// Level sums: the corrections and, for the single-level comparison, P_l
+struct LevelSums {
+    PathStats diff;
+    PathStats fine;
+};
+
+int level_steps(const Setup& s, int level) {
+    int steps = s.base_steps;
+    for (int l = 0; l < level; ++l) {
+        steps *= s.refinement;
+    }
+    return steps;
+}
+
+double discounted_payoff(const Setup& s, double S_T, double average) {
+    double S = s.product == MLMCProduct::Asian ? average : S_T;
+    return s.discount * (s.payoff.call ? european_call(S, s.payoff.K) : european_put(S, s.payoff.K));
+}
+
+Sample sample_path(const Setup& s, int level, int steps, std::uint64_t i) {
+    RngStream rng(s.seed, (static_cast<std::uint64_t>(level) + 1) << kLevelStreamShift | i);
+    const double dt = s.T / steps;
+    const double sqrt_dt = std::sqrt(dt);
+
+    Sample sample;
+    if (level == 0) {
+        double S = s.S0;
+        double sum = 0.0;
+        for (int n = 0; n < steps; ++n) {
+            S += S * (s.r * dt + s.sigma * sqrt_dt * rng.normal());
+            sum += S;
+        }
+        sample.fine = discounted_payoff(s, S, sum / steps);
+        sample.diff = sample.fine;
+        return sample;
+    }
+
+    // The coarse path takes one step per M fine steps, driven by the sum
+    // of their Brownian increments
+    const int M = s.refinement;
+    const double dt_coarse = M * dt;
+    double S_fine = s.S0;
+    double S_coarse = s.S0;
+    double sum_fine = 0.0;
+    double sum_coarse = 0.0;
+    for (int n = 0; n < steps; n += M) {
+        double dW_coarse = 0.0;
+        for (int m = 0; m < M; ++m) {
+            double dW = sqrt_dt * rng.normal();
+            S_fine += S_fine * (s.r * dt + s.sigma * dW);
+            sum_fine += S_fine;
+            dW_coarse += dW;
+        }
+        S_coarse += S_coarse * (s.r * dt_coarse + s.sigma * dW_coarse);
+        sum_coarse += S_coarse;
+    }
+    sample.fine = discounted_payoff(s, S_fine, sum_fine / steps);
+    sample.diff = sample.fine - discounted_payoff(s, S_coarse, sum_coarse / (steps / M));
+    return sample;
+}
+
+// Samples [first, first + count) of a level, reduced in the canonical tree
+LevelSums simulate_level(const Setup& s, int level, int n_threads, std::int64_t first, std::int64_t count) {
+    enum { kDiff, kFine };
+    const int steps = level_steps(s, level);
+
+    auto leaf_fn = [&](const LeafTask& task, PathStats* leaf_sums) {
+        for (int k = 0; k < task.count; ++k) {
+            Sample sample = sample_path(s, level, steps, static_cast<std::uint64_t>(first + task.first + k));
+            leaf_sums[kDiff].add(sample.diff);
+            leaf_sums[kFine].add(sample.fine);
+        }
+    };
+    const std::vector<PathStats> totals = reduce_leaves(n_threads, count, 2, leaf_fn);
+
+    LevelSums sums;
+    sums.diff = totals[kDiff];
+    sums.fine = totals[kFine];
+    return sums;
+}
+
+double mean(const PathStats& stats) {
+    return stats.sum / stats.count;
+}
+
+double variance(const PathStats& stats) {
+    double m = mean(stats);
+    return std::max(stats.sum_sq / stats.count - m * m, 0.0);
+}
+
+} // namespace
+
+MLMCResult mlmc_price(PricingContext& context, const GBMParams& p, double r, const PayoffSpec& payoff,
+                      MLMCProduct product, const MLMCOptions& options) {
+    if (!(options.target_rmse > 0.0) || !std::isfinite(options.target_rmse)) {
+        throw std::invalid_argument("Target RMSE must be positive and finite");
+    }
+    if (options.base_steps <= 0) {
+        throw std::invalid_argument("Base steps must be positive");
+    }
+    if (options.refinement < 2) {
+        throw std::invalid_argument("Refinement factor must be at least 2");
+    }
+    if (options.max_levels < 3) {
+        throw std::invalid_argument("MLMC needs at least 3 levels");
+    }
+    if (options.pilot_paths < 2) {
+        throw std::invalid_argument("Pilot paths must be at least 2");
+    }
+    if (options.base_steps * std::pow(double(options.refinement), options.max_levels - 1) > 1 << 30) {
+        throw std::invalid_argument("Finest level has too many time steps");
+    }
+
+    // Model, rate and payoff checks are those of a plan on the base grid
+    GBMParams base = p;
+    base.steps = options.base_steps;
+    PricingPlan plan(base, r, payoff, EngineOptions{options.pilot_paths, options.seed});
+
+    Setup s = {p.S0, p.sigma, p.T, r, plan.discount_factor(), payoff, product,
+               options.base_steps, options.refinement, options.seed};
+    const double eps = options.target_rmse;
+    const double M = options.refinement;
+
+    std::vector<LevelSums> sums(3);
+    std::vector<std::int64_t> pending(3, options.pilot_paths);
+    std::vector<double> seconds(3, 0.0);
+
+    auto cost_of = [&s](int level) {
+        double fine = level_steps(s, level);
+        return level == 0 ? fine : fine + fine / s.refinement;
+    };
+
+    MLMCResult result;
+    result.converged = false;
+    result.bias = 0.0;
+    for (;;) {
+        const int L = static_cast<int>(sums.size());
+        for (int l = 0; l < L; ++l) {
+            if (pending[l] > 0) {
+                auto start = std::chrono::steady_clock::now();
+                LevelSums batch = simulate_level(s, l, context.threads(), sums[l].diff.count, pending[l]);
+                sums[l].diff.merge(batch.diff);
+                sums[l].fine.merge(batch.fine);
+                seconds[l] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                pending[l] = 0;
+            }
+        }
+
+        // Optimal samples per level for a variance of eps^2 / 2
+        double sum_sqrt_vc = 0.0;
+        for (int l = 0; l < L; ++l) {
+            sum_sqrt_vc += std::sqrt(variance(sums[l].diff) * cost_of(l));
+        }
+        bool resample = false;
+        for (int l = 0; l < L; ++l) {
+            double optimal = std::ceil(2.0 / (eps * eps) * std::sqrt(variance(sums[l].diff) / cost_of(l)) *
+                                       sum_sqrt_vc);
+            std::int64_t missing = static_cast<std::int64_t>(optimal) - sums[l].diff.count;
+            if (missing > kAllocationTolerance * sums[l].diff.count) {
+                pending[l] = missing;
+                resample = true;
+            }
+        }
+        if (resample) {
+            continue;
+        }
+
+        // Remaining bias from the finest corrections, assuming weak order 1
+        result.bias = std::max(std::abs(mean(sums[L - 1].diff)), std::abs(mean(sums[L - 2].diff)) / M) /
+                      (M - 1.0);
+        if (result.bias <= eps / std::sqrt(2.0)) {
+            result.converged = true;
+            break;
+        }
+        if (L == options.max_levels) {
+            break;
+        }
+        sums.emplace_back();
+        pending.push_back(options.pilot_paths);
+        seconds.push_back(0.0);
+    }
+
+    const int L = static_cast<int>(sums.size());
+    result.price = 0.0;
+    result.cost = 0.0;
+    double error_variance = 0.0;
+    for (int l = 0; l < L; ++l) {
+        MLMCLevel level;
+        level.steps = level_steps(s, l);
+        level.paths = sums[l].diff.count;
+        level.mean = mean(sums[l].diff);
+        level.variance = variance(sums[l].diff);
+        level.fine_variance = variance(sums[l].fine);
+        level.cost = cost_of(l);
+        level.seconds = seconds[l];
+        result.levels.push_back(level);
+
+        result.price += level.mean;
+        result.cost += level.paths * level.cost;
+        error_variance += level.variance / level.paths;
+    }
+    result.stderr = std::sqrt(error_variance);
+
+    // Plain MC on the finest grid needs 2 V[P_L] / eps^2 paths for the same
+    // variance budget
+    const MLMCLevel& finest = result.levels.back();
+    result.single_level_cost = 2.0 * finest.fine_variance / (eps * eps) * finest.steps;
+    return result;
+}
@@ -0,0 +1,277 @@
+#include "path_store.hpp"
+#include "payoffs.hpp"
+#include "random_utils.hpp"
+#include "reduction_tree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+const char kMagic[8] = {'M', 'C', 'P', 'A', 'T', 'H', 'S', '\0'};
+const std::uint32_t kVersion = 1;
+
+std::size_t value_size(PathPrecision precision) {
+    return precision == PathPrecision::Float32 ? sizeof(float) : sizeof(double);
+}
+
+std::size_t chunk_bytes(const PathStoreHeader& header) {
+    return static_cast<std::size_t>(header.steps + 1) * header.chunk_paths *
+           value_size(static_cast<PathPrecision>(header.precision));
+}
+
+std::size_t chunk_count(const PathStoreHeader& header) {
+    return (header.n_paths + header.chunk_paths - 1) / header.chunk_paths;
+}
+
+// Simulate one chunk of paths into its (steps + 1) x width SoA block
+template <typename T>
+void fill_chunk(T* block, std::uint64_t first_path, std::uint64_t count, std::uint64_t width,
+                const GBMParams& p, double r, std::uint64_t seed) {
+    double dt = p.T / p.steps;
+    double drift_term = (r - 0.5 * p.sigma * p.sigma) * dt;
+    double vol_sqrt_dt = p.sigma * std::sqrt(dt);
+
+    for (std::uint64_t j = 0; j < count; ++j) {
+        RngStream rng(seed, first_path + j);
+        double current_price = p.S0;
+        block[j] = static_cast<T>(current_price);
+        for (int i = 1; i <= p.steps; ++i) {
+            double diffusion_term = vol_sqrt_dt * rng.normal();
+            current_price = current_price * std::exp(drift_term + diffusion_term);
+            block[static_cast<std::uint64_t>(i) * width + j] = static_cast<T>(current_price);
+        }
+    }
+}
+
+// Sum discounted payoffs over the terminal rows in reduction leaves
+template <typename T>
+MCResult price_terminal_rows(const PathStoreReader& store, double K, bool call) {
+    const PathStoreHeader& header = store.header();
+    const double discount_factor = std::exp(-header.r * header.T);
+    const std::int64_t width = static_cast<std::int64_t>(header.chunk_paths);
+    const int last_step = static_cast<int>(header.steps);
+
+    // Leaves follow path indices, which may straddle chunk boundaries
+    auto leaf_fn = [&](const LeafTask& task, PathStats* sums) {
+        std::int64_t path = task.first;
+        const std::int64_t end = task.first + task.count;
+        while (path < end) {
+            const std::int64_t c = path / width;
+            const std::int64_t offset = path - c * width;
+            const std::int64_t stop = std::min(end, (c + 1) * width);
+            const T* terminal = store.row<T>(c, last_step) + offset;
+            for (std::int64_t j = 0; j < stop - path; ++j) {
+                double S_T = static_cast<double>(terminal[j]);
+                double payoff = call ? european_call(S_T, K) : european_put(S_T, K);
+                sums[0].add(discount_factor * payoff);
+            }
+            path = stop;
+        }
+    };
+#ifdef _OPENMP
+    const int n_threads = omp_get_max_threads();
+#else
+    const int n_threads = 1;
+#endif
+    return estimate_price(reduce_leaves(n_threads, store.n_paths(), 1, leaf_fn).front());
+}
+
+} // namespace
+
+void write_path_store(const std::string& filename, const GBMParams& p, double r,
+                      std::int64_t n_paths, std::uint64_t seed,
+                      PathPrecision precision, std::int64_t chunk_paths) {
+    // Validate everything before touching the file or entering a parallel region
+    if (p.S0 <= 0.0) {
+        throw std::invalid_argument("Initial stock price S0 must be positive");
+    }
+    if (p.sigma < 0.0) {
+        throw std::invalid_argument("Volatility sigma must be non-negative");
+    }
+    if (p.T <= 0.0) {
+        throw std::invalid_argument("Time to maturity T must be positive");
+    }
+    if (p.steps <= 0) {
+        throw std::invalid_argument("Number of steps must be positive");
+    }
+    if (r < 0.0) {
+        throw std::invalid_argument("Risk-free rate r must be non-negative");
+    }
+    if (n_paths <= 0) {
+        throw std::invalid_argument("Number of paths must be positive");
+    }
+    if (chunk_paths <= 0) {
+        throw std::invalid_argument("Chunk size must be positive");
+    }
+    if (precision != PathPrecision::Float32 && precision != PathPrecision::Float64) {
+        throw std::invalid_argument("Unknown path precision");
+    }
+
+    PathStoreHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.precision = static_cast<std::uint32_t>(precision);
+    header.generator = static_cast<std::uint32_t>(PathGenerator::Xoshiro256StarStarPolar);
+    header.steps = static_cast<std::uint32_t>(p.steps);
+    header.n_paths = static_cast<std::uint64_t>(n_paths);
+    header.chunk_paths = static_cast<std::uint64_t>(chunk_paths);
+    header.seed = seed;
+    header.S0 = p.S0;
+    header.sigma = p.sigma;
+    header.T = p.T;
+    header.r = r;
+
+    std::size_t per_chunk = chunk_bytes(header);
+    std::size_t n_chunks = chunk_count(header);
+    std::size_t file_size = kPathStoreDataOffset + n_chunks * per_chunk;
+
+    // Build the store under a unique name next to the target and rename it
+    // into place: readers that have the old file mapped keep their pages,
+    // and no reader ever sees a half-written store
+    std::string temp_name = filename + ".XXXXXX";
+    int fd = ::mkstemp(&temp_name[0]);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot create path store: " + filename);
+    }
+    auto fail = [&](const std::string& message) {
+        ::close(fd);
+        ::unlink(temp_name.c_str());
+        throw std::runtime_error(message + filename);
+    };
+    if (::fchmod(fd, 0644) != 0 || ::ftruncate(fd, static_cast<off_t>(file_size)) != 0) {
+        fail("Cannot size path store: ");
+    }
+    void* mapping = ::mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        fail("Cannot map path store: ");
+    }
+
+    unsigned char* base = static_cast<unsigned char*>(mapping);
+    std::memcpy(base, &header, sizeof(header));
+
+    // Each chunk is an independent block of the file, so chunks fill in parallel
+    std::int64_t chunks = static_cast<std::int64_t>(n_chunks);
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (std::int64_t c = 0; c < chunks; ++c) {
+        std::uint64_t first_path = static_cast<std::uint64_t>(c) * header.chunk_paths;
+        std::uint64_t count = std::min(header.chunk_paths, header.n_paths - first_path);
+        unsigned char* block = base + kPathStoreDataOffset + static_cast<std::size_t>(c) * per_chunk;
+        if (precision == PathPrecision::Float32) {
+            fill_chunk(reinterpret_cast<float*>(block), first_path, count,
+                       header.chunk_paths, p, r, seed);
+        } else {
+            fill_chunk(reinterpret_cast<double*>(block), first_path, count,
+                       header.chunk_paths, p, r, seed);
+        }
+    }
+
+    bool synced = ::msync(mapping, file_size, MS_SYNC) == 0;
+    ::munmap(mapping, file_size);
+    if (!synced || ::fsync(fd) != 0) {
+        fail("Cannot flush path store: ");
+    }
+    ::close(fd);
+    if (std::rename(temp_name.c_str(), filename.c_str()) != 0) {
+        ::unlink(temp_name.c_str());
+        throw std::runtime_error("Cannot publish path store: " + filename);
+    }
+}
+
+PathStoreReader::PathStoreReader(const std::string& filename)
+    : mapping(nullptr), mapped_size(0), info(nullptr) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open path store: " + filename);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < kPathStoreDataOffset) {
+        ::close(fd);
+        throw std::runtime_error("Path store is truncated: " + filename);
+    }
+    mapped_size = static_cast<std::size_t>(st.st_size);
+    mapping = ::mmap(nullptr, mapped_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throw std::runtime_error("Cannot map path store: " + filename);
+    }
+
+    info = static_cast<const PathStoreHeader*>(mapping);
+    bool valid = std::memcmp(info->magic, kMagic, sizeof(kMagic)) == 0 &&
+                 info->version == kVersion &&
+                 (info->precision == static_cast<std::uint32_t>(PathPrecision::Float32) ||
+                  info->precision == static_cast<std::uint32_t>(PathPrecision::Float64)) &&
+                 info->steps > 0 && info->n_paths > 0 && info->chunk_paths > 0 &&
+                 mapped_size >= kPathStoreDataOffset + chunk_count(*info) * chunk_bytes(*info);
+    if (!valid) {
+        ::munmap(mapping, mapped_size);
+        mapping = nullptr;
+        throw std::runtime_error("Not a valid path store: " + filename);
+    }
+
+    // Payoff passes read chunks front to back
+    ::madvise(mapping, mapped_size, MADV_SEQUENTIAL);
+}
+
+PathStoreReader::~PathStoreReader() {
+    if (mapping) {
+        ::munmap(mapping, mapped_size);
+    }
+}
+
+GBMParams PathStoreReader::params() const {
+    GBMParams p = {info->S0, info->sigma, info->T, static_cast<int>(info->steps)};
+    return p;
+}
+
+std::int64_t PathStoreReader::n_chunks() const {
+    return static_cast<std::int64_t>(chunk_count(*info));
+}
+
+std::int64_t PathStoreReader::chunk_size(std::int64_t chunk) const {
+    std::uint64_t first_path = static_cast<std::uint64_t>(chunk) * info->chunk_paths;
+    return static_cast<std::int64_t>(std::min(info->chunk_paths, info->n_paths - first_path));
+}
+
+const unsigned char* PathStoreReader::chunk_base(std::int64_t chunk) const {
+    return static_cast<const unsigned char*>(mapping) + kPathStoreDataOffset +
+           static_cast<std::size_t>(chunk) * chunk_bytes(*info);
+}
+
+template <typename T>
+const T* PathStoreReader::row(std::int64_t chunk, int step) const {
+    if (value_size(precision()) != sizeof(T)) {
+        throw std::logic_error("Requested type does not match path store precision");
+    }
+    const T* block = reinterpret_cast<const T*>(chunk_base(chunk));
+    return block + static_cast<std::size_t>(step) * info->chunk_paths;
+}
+
+template const float* PathStoreReader::row<float>(std::int64_t, int) const;
+template const double* PathStoreReader::row<double>(std::int64_t, int) const;
+
+MCResult price_from_store(const PathStoreReader& store, double K, bool call) {
+    if (K <= 0.0) {
+        throw std::invalid_argument("Strike price K must be positive");
+    }
+    if (store.precision() == PathPrecision::Float32) {
+        return price_terminal_rows<float>(store, K, call);
+    }
+    return price_terminal_rows<double>(store, K, call);
+}
@@ -0,0 +1,254 @@
+#include "pde_solver.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Thomas factorization of (I - theta dtau L) for every strike, node-major
+struct Factor {
+    double theta;
+    double dtau;
+    std::vector<double> lower;  // -theta dtau a_i
+    std::vector<double> upper;  // Modified super-diagonal c'_i
+    std::vector<double> inv;    // 1 / modified diagonal
+};
+
+} // namespace
+
+std::vector<PDEResult> pde_price(double S0, double r, double sigma, double T, const std::vector<PayoffSpec>& payoffs,
+                                 const PDEOptions& options, const BarrierSpec& barrier) {
+    // Validate input parameters
+    if (S0 <= 0.0) {
+        throw std::invalid_argument("Initial stock price S0 must be positive");
+    }
+    if (!(sigma > 0.0)) {
+        throw std::invalid_argument("Volatility sigma must be positive for the PDE solver");
+    }
+    if (T <= 0.0) {
+        throw std::invalid_argument("Time to maturity T must be positive");
+    }
+    if (r < 0.0) {
+        throw std::invalid_argument("Risk-free rate r must be non-negative");
+    }
+    if (payoffs.empty()) {
+        throw std::invalid_argument("PDE solver needs at least one payoff");
+    }
+    for (const PayoffSpec& payoff : payoffs) {
+        if (payoff.K <= 0.0) {
+            throw std::invalid_argument("Strike price K must be positive");
+        }
+    }
+    if (options.space_nodes < 4 || options.time_steps < 1 || options.rannacher_steps < 0 ||
+        options.rannacher_steps > options.time_steps || !(options.concentration > 0.0) || !(options.width > 0.0)) {
+        throw std::invalid_argument("PDE grid needs at least 4 space nodes, 1 time step, "
+                                    "0 <= rannacher_steps <= time_steps and positive concentration and width");
+    }
+    if (!(barrier.lower >= 0.0) || !(barrier.upper > barrier.lower)) {
+        throw std::invalid_argument("Barriers must satisfy 0 <= lower < upper");
+    }
+
+    const std::size_t M = payoffs.size();
+    const int N = options.space_nodes;
+    const bool lower_barrier = barrier.lower > 0.0;
+    const bool upper_barrier = std::isfinite(barrier.upper);
+
+    // Sinh-stretched grid per strike, node-major: S[i * M + j]
+    std::vector<double> S((N + 1) * M);
+    std::vector<double> stretch(M);   // c of each strike
+    std::vector<double> center(M);    // Where the nodes concentrate
+    std::vector<double> xi_lo(M);
+    std::vector<double> dxi(M);
+    for (std::size_t j = 0; j < M; ++j) {
+        const double K = payoffs[j].K;
+        const double lo = barrier.lower;
+        const double hi = upper_barrier ? barrier.upper
+                                        : std::max({S0, K, barrier.lower}) * std::exp(options.width * sigma * std::sqrt(T));
+        center[j] = std::min(std::max(K, lo), hi);
+        stretch[j] = options.concentration * K;
+        xi_lo[j] = std::asinh((lo - center[j]) / stretch[j]);
+        dxi[j] = (std::asinh((hi - center[j]) / stretch[j]) - xi_lo[j]) / N;
+        for (int i = 1; i < N; ++i) {
+            S[i * M + j] = center[j] + stretch[j] * std::sinh(xi_lo[j] + i * dxi[j]);
+        }
+        S[j] = lo;
+        S[N * M + j] = hi;
+    }
+
+    // Three-point operator L V = a V_{i-1} + b V_i + c V_{i+1} at interior nodes
+    std::vector<double> a((N + 1) * M, 0.0);
+    std::vector<double> b((N + 1) * M, 0.0);
+    std::vector<double> c((N + 1) * M, 0.0);
+    for (int i = 1; i < N; ++i) {
+        for (std::size_t j = 0; j < M; ++j) {
+            const std::size_t n = i * M + j;
+            const double h_minus = S[n] - S[n - M];
+            const double h_plus = S[n + M] - S[n];
+            const double h_sum = h_minus + h_plus;
+            const double diffusion = 0.5 * sigma * sigma * S[n] * S[n];
+            const double convection = r * S[n];
+            a[n] = diffusion * 2.0 / (h_minus * h_sum) - convection * h_plus / (h_minus * h_sum);
+            b[n] = -diffusion * 2.0 / (h_minus * h_plus) + convection * (h_plus - h_minus) / (h_minus * h_plus) - r;
+            c[n] = diffusion * 2.0 / (h_plus * h_sum) + convection * h_minus / (h_plus * h_sum);
+        }
+    }
+
+    auto factor = [&](double theta, double dtau) {
+        Factor f{theta, dtau, std::vector<double>((N + 1) * M), std::vector<double>((N + 1) * M),
+                 std::vector<double>((N + 1) * M)};
+        for (int i = 1; i < N; ++i) {
+            for (std::size_t j = 0; j < M; ++j) {
+                const std::size_t n = i * M + j;
+                const double lower = -theta * dtau * a[n];
+                const double diag = 1.0 - theta * dtau * b[n];
+                const double upper = -theta * dtau * c[n];
+                const double den = i == 1 ? diag : diag - lower * f.upper[n - M];
+                f.lower[n] = lower;
+                f.inv[n] = 1.0 / den;
+                f.upper[n] = upper * f.inv[n];
+            }
+        }
+        return f;
+    };
+
+    // Rannacher start-up: implicit Euler half steps, then Crank-Nicolson
+    const double dt = T / options.time_steps;
+    const Factor implicit = factor(1.0, 0.5 * dt);
+    const Factor crank_nicolson = factor(0.5, dt);
+
+    // Dirichlet values: discounted intrinsic value, zero at a barrier
+    std::vector<double> strike(M);
+    std::vector<double> low_strike(M);    // K where V(lo) = K e^{-r tau}, else 0
+    std::vector<double> high_strike(M);   // K where V(hi) = hi - K e^{-r tau}, else 0
+    std::vector<double> high_spot(M);     // hi where V(hi) = hi - K e^{-r tau}, else 0
+    for (std::size_t j = 0; j < M; ++j) {
+        strike[j] = payoffs[j].K;
+        const bool call = payoffs[j].call;
+        low_strike[j] = !call && !lower_barrier ? payoffs[j].K : 0.0;
+        high_strike[j] = call && !upper_barrier ? payoffs[j].K : 0.0;
+        high_spot[j] = call && !upper_barrier ? S[N * M + j] : 0.0;
+    }
+
+    // Payoff at expiry; knocked out on a barrier node
+    std::vector<double> V((N + 1) * M);
+    for (int i = 0; i <= N; ++i) {
+        for (std::size_t j = 0; j < M; ++j) {
+            const std::size_t n = i * M + j;
+            V[n] = payoffs[j].call ? std::max(S[n] - strike[j], 0.0) : std::max(strike[j] - S[n], 0.0);
+        }
+    }
+    for (std::size_t j = 0; j < M; ++j) {
+        if (lower_barrier) {
+            V[j] = 0.0;
+        }
+        if (upper_barrier) {
+            V[N * M + j] = 0.0;
+        }
+    }
+
+    std::vector<double> d((N + 1) * M);
+    double tau = 0.0;
+    auto step = [&](const Factor& f) {
+        const double explicit_weight = (1.0 - f.theta) * f.dtau;
+        const double implicit_weight = f.theta * f.dtau;
+        tau += f.dtau;
+        const double growth = std::exp(-r * tau);
+
+        // Right-hand side (I + (1 - theta) dtau L) V
+        for (int i = 1; i < N; ++i) {
+            const double* v_prev = &V[(i - 1) * M];
+            const double* v = &V[i * M];
+            const double* v_next = &V[(i + 1) * M];
+            const double* a_i = &a[i * M];
+            const double* b_i = &b[i * M];
+            const double* c_i = &c[i * M];
+            double* d_i = &d[i * M];
+            for (std::size_t j = 0; j < M; ++j) {
+                d_i[j] = v[j] + explicit_weight * (a_i[j] * v_prev[j] + b_i[j] * v[j] + c_i[j] * v_next[j]);
+            }
+        }
+
+        // New boundary values enter the first and last equations
+        for (std::size_t j = 0; j < M; ++j) {
+            const double low = low_strike[j] * growth;
+            const double high = high_spot[j] - high_strike[j] * growth;
+            d[M + j] += implicit_weight * a[M + j] * low;
+            d[(N - 1) * M + j] += implicit_weight * c[(N - 1) * M + j] * high;
+            V[j] = low;
+            V[N * M + j] = high;
+        }
+
+        // Thomas sweeps, vectorized across strikes
+        for (std::size_t j = 0; j < M; ++j) {
+            d[M + j] *= f.inv[M + j];
+        }
+        for (int i = 2; i < N; ++i) {
+            const double* d_prev = &d[(i - 1) * M];
+            double* d_i = &d[i * M];
+            const double* lower = &f.lower[i * M];
+            const double* inv = &f.inv[i * M];
+            for (std::size_t j = 0; j < M; ++j) {
+                d_i[j] = (d_i[j] - lower[j] * d_prev[j]) * inv[j];
+            }
+        }
+        for (std::size_t j = 0; j < M; ++j) {
+            V[(N - 1) * M + j] = d[(N - 1) * M + j];
+        }
+        for (int i = N - 2; i >= 1; --i) {
+            const double* v_next = &V[(i + 1) * M];
+            double* v = &V[i * M];
+            const double* d_i = &d[i * M];
+            const double* upper = &f.upper[i * M];
+            for (std::size_t j = 0; j < M; ++j) {
+                v[j] = d_i[j] - upper[j] * v_next[j];
+            }
+        }
+    };
+
+    for (int k = 0; k < options.time_steps; ++k) {
+        if (k < options.rannacher_steps) {
+            step(implicit);
+            step(implicit);
+        } else {
+            step(crank_nicolson);
+        }
+    }
+
+    // Quadratics through the stencils of the two nodes bracketing S0,
+    // blended linearly in S so gamma is smooth between nodes
+    auto quadratic = [&](std::size_t j, int k) {
+        const double x0 = S[(k - 1) * M + j];
+        const double x1 = S[k * M + j];
+        const double x2 = S[(k + 1) * M + j];
+        const double w0 = V[(k - 1) * M + j] / ((x0 - x1) * (x0 - x2));
+        const double w1 = V[k * M + j] / ((x1 - x0) * (x1 - x2));
+        const double w2 = V[(k + 1) * M + j] / ((x2 - x0) * (x2 - x1));
+        PDEResult result;
+        result.price = w0 * (S0 - x1) * (S0 - x2) + w1 * (S0 - x0) * (S0 - x2) + w2 * (S0 - x0) * (S0 - x1);
+        result.delta = w0 * (2.0 * S0 - x1 - x2) + w1 * (2.0 * S0 - x0 - x2) + w2 * (2.0 * S0 - x0 - x1);
+        result.gamma = 2.0 * (w0 + w1 + w2);
+        return result;
+    };
+
+    std::vector<PDEResult> results;
+    for (std::size_t j = 0; j < M; ++j) {
+        if ((lower_barrier && S0 <= barrier.lower) || (upper_barrier && S0 >= barrier.upper)) {
+            results.push_back(PDEResult{0.0, 0.0, 0.0});
+            continue;
+        }
+        const double position = (std::asinh((S0 - center[j]) / stretch[j]) - xi_lo[j]) / dxi[j];
+        const int k = std::min(std::max(static_cast<int>(std::floor(position)), 1), N - 2);
+        const double weight = (S0 - S[k * M + j]) / (S[(k + 1) * M + j] - S[k * M + j]);
+        const PDEResult left = quadratic(j, k);
+        const PDEResult right = quadratic(j, k + 1);
+        results.push_back(PDEResult{left.price + weight * (right.price - left.price),
+                                    left.delta + weight * (right.delta - left.delta),
+                                    left.gamma + weight * (right.gamma - left.gamma)});
+    }
+    return results;
+}
+
+PDEResult pde_price(double S0, double r, double sigma, double T, const PayoffSpec& payoff,
+                    const PDEOptions& options, const BarrierSpec& barrier) {
+    return pde_price(S0, r, sigma, T, std::vector<PayoffSpec>{payoff}, options, barrier).front();
+}
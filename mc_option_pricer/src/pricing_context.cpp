@@ -0,0 +1,103 @@
+#include "pricing_context.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+int resolve_threads(int threads) {
+    if (threads < 0) {
+        throw std::invalid_argument("Thread count must be non-negative");
+    }
+#ifdef _OPENMP
+    return threads == 0 ? omp_get_max_threads() : threads;
+#else
+    return 1;
+#endif
+}
+
+std::uint64_t random_seed() {
+    std::random_device device;
+    return (static_cast<std::uint64_t>(device()) << 32) | device();
+}
+
+// Stream id of the context's own generator; plans use streams 0..n_paths-1
+const std::uint64_t kContextStream = ~0ULL;
+
+} // namespace
+
+PricingContext::PricingContext(int threads)
+    : PricingContext(threads, random_seed()) {}
+
+PricingContext::PricingContext(int threads, std::uint64_t seed)
+    : n_threads(resolve_threads(threads)),
+      stream(seed, kContextStream),
+      scratch(static_cast<std::size_t>(n_threads)) {}
+
+MCResult PricingContext::run(const PricingPlan& plan) noexcept {
+    return plan.finish(run_range(plan, 0, plan.options().n_paths));
+}
+
+PathStats PricingContext::run_range(const PricingPlan& plan, std::uint64_t first_path,
+                                    std::int64_t count) noexcept {
+    auto start = std::chrono::steady_clock::now();
+
+    for (ThreadPartial& partial : scratch) {
+        partial.tree.clear();
+    }
+    ThreadPartial* partials = scratch.data();
+    const std::int64_t leaf_size = plan.leaf_paths();
+    const std::int64_t leaves = (count + leaf_size - 1) / leaf_size;
+
+#ifdef _OPENMP
+    #pragma omp parallel num_threads(n_threads)
+#endif
+    {
+#ifdef _OPENMP
+        int thread = omp_get_thread_num();
+#else
+        int thread = 0;
+#endif
+        ReductionTree& local = partials[thread].tree;
+
+        // Static schedule: thread t owns the t-th contiguous run of leaves
+#ifdef _OPENMP
+        #pragma omp for schedule(static) nowait
+#endif
+        for (std::int64_t leaf = 0; leaf < leaves; ++leaf) {
+            std::int64_t offset = leaf * leaf_size;
+            local.add_leaf(leaf, plan.sum_paths(first_path + static_cast<std::uint64_t>(offset),
+                                                std::min(leaf_size, count - offset)));
+        }
+    }
+
+    // Append in thread order; the runtime may have granted fewer threads
+    // than requested, in which case the remaining trees are still empty
+    PathStats total;
+    {
+        MC_PROFILE_SCOPE(Reduction);
+        ReductionTree& tree = scratch[0].tree;
+        for (std::size_t t = 1; t < scratch.size(); ++t) {
+            tree.append(scratch[t].tree);
+        }
+        total = tree.total();
+    }
+
+    totals.runs += 1;
+    totals.paths += static_cast<std::uint64_t>(count);
+    totals.path_steps += static_cast<std::uint64_t>(count) * plan.params().steps;
+    totals.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return total;
+}
+
+MCResult PricingContext::price(const GBMParams& p, double K, bool call, std::int64_t n_paths, double r) {
+    PricingPlan plan(p, r, PayoffSpec{K, call}, EngineOptions{n_paths, next_seed()});
+    return run(plan);
+}
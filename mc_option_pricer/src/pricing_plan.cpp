@@ -0,0 +1,288 @@
+#include "pricing_plan.hpp"
+#include "payoffs.hpp"
+#include "profiler.hpp"
+#include "random_utils.hpp"
+#include "reduction_tree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+// Normals drawn per block; bounds the stack scratch of run()
+const int kNormalBlock = 64;
+
+} // namespace
+
+MCResult estimate_price(const PathStats& stats) noexcept {
+    const double n = static_cast<double>(stats.count);
+
+    // Calculate mean, variance and standard error
+    double mean_payoff = stats.sum / n;
+    double mean_squared_payoff = stats.sum_sq / n;
+    double variance = mean_squared_payoff - mean_payoff * mean_payoff;
+
+    // Samples are single paths unless a batch correction is enabled; the
+    // spread of fewer than two samples says nothing about the error
+    MCResult result;
+    result.price = mean_payoff;
+    result.stderr = stats.samples < 2
+                        ? std::numeric_limits<double>::quiet_NaN()
+                        : std::sqrt(std::max(variance, 0.0) / static_cast<double>(stats.samples - 1));
+    return result;
+}
+
+PricingPlan::PricingPlan(const GBMParams& p, double r, const PayoffSpec& payoff,
+                         const EngineOptions& options)
+    : model(p), r(r), spec(payoff), engine(options) {
+    // Validate input parameters
+    if (p.S0 <= 0.0) {
+        throw std::invalid_argument("Initial stock price S0 must be positive");
+    }
+    if (p.sigma < 0.0) {
+        throw std::invalid_argument("Volatility sigma must be non-negative");
+    }
+    if (p.T <= 0.0) {
+        throw std::invalid_argument("Time to maturity T must be positive");
+    }
+    if (p.steps <= 0) {
+        throw std::invalid_argument("Number of steps must be positive");
+    }
+    if (r < 0.0) {
+        throw std::invalid_argument("Risk-free rate r must be non-negative");
+    }
+    if (payoff.K <= 0.0) {
+        throw std::invalid_argument("Strike price K must be positive");
+    }
+    if (options.n_paths <= 0) {
+        throw std::invalid_argument("Number of paths must be positive");
+    }
+    if (!std::isfinite(options.drift_shift)) {
+        throw std::invalid_argument("Drift shift must be finite");
+    }
+    if ((options.moment_matching || options.martingale_correction) &&
+        options.n_paths < 2 * kCorrectionBatchPaths) {
+        throw std::invalid_argument("Batch corrections need at least two full batches of paths");
+    }
+
+    // Fold the per-step constants once
+    time_step = p.T / p.steps;
+    step_drift = (r - 0.5 * p.sigma * p.sigma) * time_step;
+    step_vol = p.sigma * std::sqrt(time_step);
+    discount = std::exp(-r * p.T);
+    step_shift = options.drift_shift / std::sqrt(static_cast<double>(p.steps));
+}
+
+double PricingPlan::path_payoff(std::uint64_t i) const noexcept {
+    double z_sum;
+    double log_price = log_return(i, z_sum);
+    return terminal_payoff(log_price, z_sum);
+}
+
+double PricingPlan::terminal_growth(std::uint64_t i) const noexcept {
+    double z_sum;
+    return std::exp(log_return(i, z_sum));
+}
+
+TerminalDriver PricingPlan::terminal_driver(std::uint64_t i) const noexcept {
+    const double z_sum = normal_sum(i);
+    if (step_shift == 0.0) {
+        return TerminalDriver{z_sum, 1.0};
+    }
+    return TerminalDriver{z_sum + model.steps * step_shift, likelihood_ratio(z_sum)};
+}
+
+double PricingPlan::normal_sum(std::uint64_t i) const noexcept {
+    RngStream rng(engine.seed, i);
+    double z_sum = 0.0;
+    for (int j = 0; j < model.steps; ++j) {
+        z_sum += rng.normal();
+    }
+    return z_sum;
+}
+
+double PricingPlan::log_return(std::uint64_t i, double& z_sum) const noexcept {
+    const int steps = model.steps;
+    double Z[kNormalBlock];
+
+    // Path i always draws from stream i, independent of thread assignment
+    RngStream rng(engine.seed, i);
+
+    // The shift moves every normal, so it folds into the per-step drift
+    const double drift = step_drift + step_vol * step_shift;
+
+    double log_price = 0.0;
+    z_sum = 0.0;
+    for (int done = 0; done < steps; done += kNormalBlock) {
+        int block = std::min(kNormalBlock, steps - done);
+        {
+            MC_PROFILE_SCOPE(Rng);
+            for (int j = 0; j < block; ++j) {
+                Z[j] = rng.normal();
+            }
+        }
+        MC_PROFILE_SCOPE(Step);
+        for (int j = 0; j < block; ++j) {
+            log_price += drift + step_vol * Z[j];
+            z_sum += Z[j];
+        }
+    }
+    MC_PROFILE_COUNT(Steps, steps);
+
+    return log_price;
+}
+
+double PricingPlan::payoff_from_normals(const double* Z) const noexcept {
+    const int steps = model.steps;
+    const double drift = step_drift + step_vol * step_shift;
+
+    double log_price = 0.0;
+    double z_sum = 0.0;
+    {
+        MC_PROFILE_SCOPE(Step);
+        for (int j = 0; j < steps; ++j) {
+            log_price += drift + step_vol * Z[j];
+            z_sum += Z[j];
+        }
+    }
+    MC_PROFILE_COUNT(Steps, steps);
+
+    return terminal_payoff(log_price, z_sum);
+}
+
+double PricingPlan::terminal_payoff(double log_price, double z_sum) const noexcept {
+    MC_PROFILE_SCOPE(Payoff);
+    double S_T = model.S0 * std::exp(log_price);
+    double payoff = spec.call ? european_call(S_T, spec.K) : european_put(S_T, spec.K);
+    MC_PROFILE_COUNT(Paths, 1);
+    if (step_shift != 0.0) {
+        payoff *= likelihood_ratio(z_sum);
+    }
+    return discount * payoff;
+}
+
+double PricingPlan::likelihood_ratio(double z_sum) const noexcept {
+    return std::exp(-step_shift * z_sum - 0.5 * model.steps * step_shift * step_shift);
+}
+
+double PricingPlan::corrected_batch_sum(std::uint64_t first_path, std::int64_t count) const noexcept {
+    const int steps = model.steps;
+    const double drift = step_drift + step_vol * step_shift;
+    double z[kCorrectionBatchPaths];  // Terminal drivers, sum_j Z_j
+
+    {
+        MC_PROFILE_SCOPE(Rng);
+        for (std::int64_t k = 0; k < count; ++k) {
+            z[k] = normal_sum(first_path + static_cast<std::uint64_t>(k));
+        }
+    }
+    MC_PROFILE_COUNT(Steps, steps * count);
+
+    // A single path has no spread to match
+    if (engine.moment_matching && count > 1) {
+        double mean = 0.0;
+        for (std::int64_t k = 0; k < count; ++k) {
+            mean += z[k];
+        }
+        mean /= count;
+        double variance = 0.0;
+        for (std::int64_t k = 0; k < count; ++k) {
+            variance += (z[k] - mean) * (z[k] - mean);
+        }
+        variance /= count;
+        const double scale = variance > 0.0 ? std::sqrt(steps / variance) : 1.0;
+        for (std::int64_t k = 0; k < count; ++k) {
+            z[k] = (z[k] - mean) * scale;
+        }
+    }
+
+    // Scaling every S_T by c shifts every log price by log(c)
+    double log_scale = 0.0;
+    if (engine.martingale_correction) {
+        double mean_S = 0.0;
+        for (std::int64_t k = 0; k < count; ++k) {
+            double S_T = model.S0 * std::exp(steps * drift + step_vol * z[k]);
+            mean_S += step_shift != 0.0 ? likelihood_ratio(z[k]) * S_T : S_T;
+        }
+        mean_S /= count;
+        log_scale = std::log(model.S0 / discount) - std::log(mean_S);
+    }
+
+    double sum = 0.0;
+    for (std::int64_t k = 0; k < count; ++k) {
+        sum += terminal_payoff(steps * drift + step_vol * z[k] + log_scale, z[k]);
+    }
+    return sum;
+}
+
+MCResult PricingPlan::run() const noexcept {
+    return finish(run_range(0, engine.n_paths));
+}
+
+PathStats PricingPlan::sum_paths(std::uint64_t first_path, std::int64_t count) const noexcept {
+    PathStats stats;
+    if (engine.moment_matching || engine.martingale_correction) {
+        for (std::int64_t done = 0; done < count; done += kCorrectionBatchPaths) {
+            std::int64_t batch = std::min(kCorrectionBatchPaths, count - done);
+            stats.add_batch(batch, corrected_batch_sum(first_path + static_cast<std::uint64_t>(done), batch));
+        }
+        return stats;
+    }
+    for (std::int64_t i = 0; i < count; ++i) {
+        stats.add(path_payoff(first_path + static_cast<std::uint64_t>(i)));
+    }
+    return stats;
+}
+
+PathStats PricingPlan::run_range(std::uint64_t first_path, std::int64_t count) const noexcept {
+    const std::int64_t leaf_size = leaf_paths();
+    const std::int64_t leaves = (count + leaf_size - 1) / leaf_size;
+    ReductionTree tree;
+
+#ifdef _OPENMP
+    #pragma omp parallel
+#endif
+    {
+        ReductionTree local;
+
+        // Static schedule: each thread owns one contiguous run of leaves,
+        // in thread order. 64-bit indices: ranges may exceed INT_MAX paths
+#ifdef _OPENMP
+        #pragma omp for schedule(static) nowait
+#endif
+        for (std::int64_t leaf = 0; leaf < leaves; ++leaf) {
+            std::int64_t offset = leaf * leaf_size;
+            local.add_leaf(leaf, sum_paths(first_path + static_cast<std::uint64_t>(offset),
+                                           std::min(leaf_size, count - offset)));
+        }
+
+        MC_PROFILE_SCOPE(Reduction);
+#ifdef _OPENMP
+        // One iteration per thread, executed in thread order
+        const int n_threads = omp_get_num_threads();
+        #pragma omp for ordered schedule(static, 1)
+        for (int t = 0; t < n_threads; ++t) {
+            #pragma omp ordered
+            tree.append(local);
+        }
+#else
+        tree.append(local);
+#endif
+    }
+
+    return tree.total();
+}
+
+std::int64_t PricingPlan::leaf_paths() const noexcept {
+    return engine.moment_matching || engine.martingale_correction ? kCorrectionBatchPaths
+                                                                  : kReductionLeafPaths;
+}
+
+MCResult PricingPlan::finish(const PathStats& stats) const noexcept {
+    return estimate_price(stats);
+}
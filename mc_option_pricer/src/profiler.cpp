@@ -0,0 +1,74 @@
+#include "profiler.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+ProfileSlot slots[kMaxProfileThreads];
+
+} // namespace
+
+bool profiler_enabled() {
+#ifdef MC_ENABLE_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+ProfileSlot& profiler_slot() {
+#ifdef _OPENMP
+    int thread = omp_get_thread_num();
+    return slots[thread < kMaxProfileThreads ? thread : kMaxProfileThreads - 1];
+#else
+    return slots[0];
+#endif
+}
+
+void profiler_reset() {
+    for (ProfileSlot& slot : slots) {
+        for (auto& cycles : slot.cycles) {
+            cycles.store(0, std::memory_order_relaxed);
+        }
+        for (auto& count : slot.counts) {
+            count.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+ProfileReport profiler_snapshot() {
+    ProfileReport report;
+    report.enabled = profiler_enabled();
+    for (int t = 0; t < kMaxProfileThreads; ++t) {
+        ThreadProfile profile;
+        bool active = false;
+        for (int i = 0; i < static_cast<int>(ProfilePhase::Count); ++i) {
+            profile.cycles[i] = slots[t].cycles[i].load(std::memory_order_relaxed);
+            active = active || profile.cycles[i] != 0;
+        }
+        for (int i = 0; i < static_cast<int>(ProfileCounter::Count); ++i) {
+            profile.counts[i] = slots[t].counts[i].load(std::memory_order_relaxed);
+            active = active || profile.counts[i] != 0;
+        }
+        if (active) {
+            report.thread_ids.push_back(t);
+            report.threads.push_back(profile);
+        }
+    }
+    return report;
+}
+
+ThreadProfile ProfileReport::total() const {
+    ThreadProfile sum = {};
+    for (const ThreadProfile& profile : threads) {
+        for (int i = 0; i < static_cast<int>(ProfilePhase::Count); ++i) {
+            sum.cycles[i] += profile.cycles[i];
+        }
+        for (int i = 0; i < static_cast<int>(ProfileCounter::Count); ++i) {
+            sum.counts[i] += profile.counts[i];
+        }
+    }
+    return sum;
+}
@@ -1,4 +1,7 @@
 #include "random_utils.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
 #include <random>
 
 double randn() {
@@ -10,3 +13,41 @@ double randn() {
     
     return distribution(engine);
 }
+
+double inverse_normal_cdf(double u) {
+    // Coefficients of Acklam's approximation
+    static const double a[6] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                                1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[5] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                                6.680131188771972e+01, -1.328068155288572e+01};
+    static const double c[6] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                                -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[4] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                                3.754408661907416e+00};
+    const double p_low = 0.02425;
+
+    // Stratified uniforms (h + u) / H can round onto 0 or 1; map them to
+    // the nearest interior probability rather than an infinite quantile
+    u = std::min(std::max(u, DBL_MIN), std::nextafter(1.0, 0.0));
+
+    double z;
+    if (u < p_low) {
+        double q = std::sqrt(-2.0 * std::log(u));
+        z = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+            ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    } else if (u <= 1.0 - p_low) {
+        double q = u - 0.5;
+        double t = q * q;
+        z = (((((a[0] * t + a[1]) * t + a[2]) * t + a[3]) * t + a[4]) * t + a[5]) * q /
+            (((((b[0] * t + b[1]) * t + b[2]) * t + b[3]) * t + b[4]) * t + 1.0);
+    } else {
+        double q = std::sqrt(-2.0 * std::log1p(-u));
+        z = -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+            ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+
+    // One Halley step brings the relative error from 1e-9 to machine precision
+    double e = 0.5 * std::erfc(-z / std::sqrt(2.0)) - u;
+    double step = e * std::sqrt(2.0 * M_PI) * std::exp(0.5 * z * z);
+    return z - step / (1.0 + 0.5 * z * step);
+}
@@ -0,0 +1,333 @@
+#include "result_cache.hpp"
+#include "black_scholes.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char kDiskMagic[4] = {'M', 'C', 'R', 'C'};
+// Version 2: thread-count independent reduction of seeded Monte Carlo sums
+// Version 3: RngStream::uniform() on 52 bits, strictly inside (0, 1)
+// Version 4: standard errors with the unbiased (samples - 1) divisor
+const std::uint32_t kDiskVersion = 4;
+
+void append_u64(std::vector<unsigned char>& out, std::uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<unsigned char>(value >> (8 * i)));
+    }
+}
+
+// Encode a double by its IEEE-754 bit pattern after canonicalization
+void append_double(std::vector<unsigned char>& out, double value) {
+    if (std::isnan(value)) {
+        throw std::invalid_argument("Pricing inputs must not be NaN");
+    }
+    if (value == 0.0) {
+        value = 0.0; // Collapse -0.0 onto +0.0
+    }
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    append_u64(out, bits);
+}
+
+} // namespace
+
+std::uint64_t fnv1a_64(const unsigned char* data, std::size_t size, std::uint64_t basis) {
+    std::uint64_t hash = basis;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+std::uint64_t hash_gbm_params(const GBMParams& p) {
+    std::vector<unsigned char> bytes;
+    bytes.reserve(32);
+    append_double(bytes, p.S0);
+    append_double(bytes, p.sigma);
+    append_double(bytes, p.T);
+    append_u64(bytes, static_cast<std::uint64_t>(static_cast<std::int64_t>(p.steps)));
+    return fnv1a_64(bytes.data(), bytes.size());
+}
+
+PricingKey PricingKey::monte_carlo(const GBMParams& p, double K, bool call,
+                                   std::int64_t n_paths, double r, std::uint64_t seed) {
+    PricingKey key;
+    key.method = PricingMethod::MonteCarlo;
+    key.call = call;
+    key.S0 = p.S0;
+    key.K = K;
+    key.r = r;
+    key.sigma = p.sigma;
+    key.T = p.T;
+    key.steps = p.steps;
+    key.n_paths = n_paths;
+    key.seed = seed;
+    return key;
+}
+
+PricingKey PricingKey::black_scholes(double S0, double K, double r, double sigma,
+                                     double T, bool call) {
+    PricingKey key;
+    key.method = PricingMethod::BlackScholes;
+    key.call = call;
+    key.S0 = S0;
+    key.K = K;
+    key.r = r;
+    key.sigma = sigma;
+    key.T = T;
+    key.steps = 0;
+    key.n_paths = 0;
+    key.seed = 0;
+    return key;
+}
+
+std::vector<unsigned char> PricingKey::canonical_bytes() const {
+    std::vector<unsigned char> bytes;
+    bytes.reserve(2 + 5 * 8 + 3 * 8);
+    bytes.push_back(static_cast<unsigned char>(method));
+    bytes.push_back(call ? 1 : 0);
+    append_double(bytes, S0);
+    append_double(bytes, K);
+    append_double(bytes, r);
+    append_double(bytes, sigma);
+    append_double(bytes, T);
+
+    // Simulation controls only identify Monte Carlo results
+    bool simulated = method == PricingMethod::MonteCarlo;
+    append_u64(bytes, simulated ? static_cast<std::uint64_t>(static_cast<std::int64_t>(steps)) : 0);
+    append_u64(bytes, simulated ? static_cast<std::uint64_t>(n_paths) : 0);
+    append_u64(bytes, simulated ? seed : 0);
+    return bytes;
+}
+
+std::uint64_t PricingKey::hash() const {
+    std::vector<unsigned char> bytes = canonical_bytes();
+    return fnv1a_64(bytes.data(), bytes.size());
+}
+
+bool PricingKey::operator==(const PricingKey& other) const {
+    return canonical_bytes() == other.canonical_bytes();
+}
+
+double CacheStats::hit_rate() const {
+    std::uint64_t lookups = hits + disk_hits + misses;
+    if (lookups == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(hits + disk_hits) / static_cast<double>(lookups);
+}
+
+ResultCache::ResultCache(std::size_t capacity, const std::string& disk_dir)
+    : max_entries(capacity), directory(disk_dir), counters() {
+    if (!directory.empty()) {
+        std::filesystem::create_directories(directory);
+    }
+}
+
+MCResult ResultCache::price_monte_carlo(const GBMParams& p, double K, bool call, std::int64_t n_paths,
+                                        double r, std::uint64_t seed) {
+    PricingKey key = PricingKey::monte_carlo(p, K, call, n_paths, r, seed);
+    MCResult result;
+    if (lookup(key, result)) {
+        return result;
+    }
+
+    // Price outside the lock so concurrent misses do not serialize
+    result = monte_carlo_price(p, K, call, n_paths, r, seed);
+    store(key, result);
+    return result;
+}
+
+double ResultCache::price_bs_call(double S0, double K, double r, double sigma, double T) {
+    PricingKey key = PricingKey::black_scholes(S0, K, r, sigma, T, true);
+    MCResult result;
+    if (lookup(key, result)) {
+        return result.price;
+    }
+    result.price = bs_call(S0, K, r, sigma, T);
+    result.stderr = 0.0;
+    store(key, result);
+    return result.price;
+}
+
+double ResultCache::price_bs_put(double S0, double K, double r, double sigma, double T) {
+    PricingKey key = PricingKey::black_scholes(S0, K, r, sigma, T, false);
+    MCResult result;
+    if (lookup(key, result)) {
+        return result.price;
+    }
+    result.price = bs_put(S0, K, r, sigma, T);
+    result.stderr = 0.0;
+    store(key, result);
+    return result.price;
+}
+
+bool ResultCache::lookup(const PricingKey& key, MCResult& out) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key);
+        if (it != index.end()) {
+            // Move to the front of the LRU list
+            lru.splice(lru.begin(), lru, it->second);
+            out = it->second->second;
+            ++counters.hits;
+            return true;
+        }
+    }
+
+    if (!directory.empty() && load_from_disk(key, out)) {
+        std::lock_guard<std::mutex> lock(mutex);
+        insert_locked(key, out);
+        ++counters.disk_hits;
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ++counters.misses;
+    return false;
+}
+
+void ResultCache::store(const PricingKey& key, const MCResult& result) {
+    bool persisted = !directory.empty() && save_to_disk(key, result);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    insert_locked(key, result);
+    if (persisted) {
+        ++counters.disk_writes;
+    }
+}
+
+void ResultCache::set_capacity(std::size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex);
+    max_entries = capacity;
+    evict_locked();
+}
+
+void ResultCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    index.clear();
+    lru.clear();
+}
+
+std::size_t ResultCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return lru.size();
+}
+
+std::size_t ResultCache::capacity() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return max_entries;
+}
+
+CacheStats ResultCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
+
+void ResultCache::reset_stats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    counters = CacheStats();
+}
+
+void ResultCache::insert_locked(const PricingKey& key, const MCResult& result) {
+    auto it = index.find(key);
+    if (it != index.end()) {
+        it->second->second = result;
+        lru.splice(lru.begin(), lru, it->second);
+        return;
+    }
+    if (max_entries == 0) {
+        return;
+    }
+    lru.emplace_front(key, result);
+    index[key] = lru.begin();
+    evict_locked();
+}
+
+void ResultCache::evict_locked() {
+    while (lru.size() > max_entries) {
+        index.erase(lru.back().first);
+        lru.pop_back();
+        ++counters.evictions;
+    }
+}
+
+std::string ResultCache::disk_path(const PricingKey& key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.mcr",
+                  static_cast<unsigned long long>(key.hash()));
+    return (std::filesystem::path(directory) / name).string();
+}
+
+// File layout: magic, version, key length, canonical key bytes, price, stderr.
+// The stored key is compared on load so hash collisions can never return a
+// result for different inputs.
+bool ResultCache::load_from_disk(const PricingKey& key, MCResult& out) const {
+    std::FILE* file = std::fopen(disk_path(key).c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+
+    std::vector<unsigned char> expected = key.canonical_bytes();
+    char magic[4];
+    std::uint32_t version = 0;
+    std::uint32_t key_size = 0;
+    bool ok = std::fread(magic, 1, 4, file) == 4 &&
+              std::memcmp(magic, kDiskMagic, 4) == 0 &&
+              std::fread(&version, sizeof(version), 1, file) == 1 &&
+              version == kDiskVersion &&
+              std::fread(&key_size, sizeof(key_size), 1, file) == 1 &&
+              key_size == expected.size();
+    if (ok) {
+        std::vector<unsigned char> stored(key_size);
+        ok = std::fread(stored.data(), 1, key_size, file) == key_size &&
+             stored == expected &&
+             std::fread(&out.price, sizeof(double), 1, file) == 1 &&
+             std::fread(&out.stderr, sizeof(double), 1, file) == 1;
+    }
+    std::fclose(file);
+    return ok;
+}
+
+bool ResultCache::save_to_disk(const PricingKey& key, const MCResult& result) const {
+    std::string path = disk_path(key);
+    // A unique temporary name, so processes storing the same key never
+    // write into each other's file
+    std::string temp_path = path + ".XXXXXX";
+    int fd = ::mkstemp(&temp_path[0]);
+    if (fd < 0) {
+        return false;
+    }
+    std::FILE* file = ::fchmod(fd, 0644) == 0 ? ::fdopen(fd, "wb") : nullptr;
+    if (!file) {
+        ::close(fd);
+        std::remove(temp_path.c_str());
+        return false;
+    }
+
+    std::vector<unsigned char> bytes = key.canonical_bytes();
+    std::uint32_t key_size = static_cast<std::uint32_t>(bytes.size());
+    bool ok = std::fwrite(kDiskMagic, 1, 4, file) == 4 &&
+              std::fwrite(&kDiskVersion, sizeof(kDiskVersion), 1, file) == 1 &&
+              std::fwrite(&key_size, sizeof(key_size), 1, file) == 1 &&
+              std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size() &&
+              std::fwrite(&result.price, sizeof(double), 1, file) == 1 &&
+              std::fwrite(&result.stderr, sizeof(double), 1, file) == 1;
+    ok = std::fclose(file) == 0 && ok;
+
+    // Rename is atomic, so readers never observe a partially written entry
+    if (!ok || std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,86 @@
+#include "scenario_grid.hpp"
+#include "payoffs.hpp"
+#include "profiler.hpp"
+#include "reduction_tree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+std::vector<double> shocked(const std::vector<double>& shocks, double base, bool relative) {
+    if (shocks.empty()) {
+        throw std::invalid_argument("Scenario grid axes must not be empty");
+    }
+    std::vector<double> values;
+    for (double shock : shocks) {
+        if (!std::isfinite(shock)) {
+            throw std::invalid_argument("Scenario shocks must be finite");
+        }
+        values.push_back(relative ? base * (1.0 + shock) : base + shock);
+    }
+    return values;
+}
+
+} // namespace
+
+ScenarioCube revalue_scenarios(PricingContext& context, const PricingPlan& plan, const ScenarioGrid& grid) {
+    const GBMParams& p = plan.params();
+    const EngineOptions& engine = plan.options();
+    const PayoffSpec payoff = plan.payoff();
+
+    if (engine.moment_matching || engine.martingale_correction) {
+        throw std::invalid_argument("Scenario revaluation does not support batch corrections");
+    }
+
+    ScenarioCube cube;
+    cube.spots = shocked(grid.spot_shocks, p.S0, true);
+    cube.vols = shocked(grid.vol_shocks, p.sigma, false);
+    cube.rates = shocked(grid.rate_shocks, plan.rate(), false);
+    if (*std::min_element(cube.spots.begin(), cube.spots.end()) <= 0.0 ||
+        *std::min_element(cube.vols.begin(), cube.vols.end()) < 0.0) {
+        throw std::invalid_argument("Shocked spot must be positive and shocked volatility non-negative");
+    }
+
+    // Scenarios in cube order
+    std::vector<ScenarioTerminal> scenarios;
+    for (double S0 : cube.spots) {
+        for (double sigma : cube.vols) {
+            for (double r : cube.rates) {
+                scenarios.push_back(ScenarioTerminal::at(S0, sigma, p.T, r, p.steps));
+            }
+        }
+    }
+
+    // One pass over each path's normals serves the task's scenarios; when
+    // the leaves alone cannot occupy the threads, the scenarios are split
+    // as well and each block redraws its normals
+    auto leaf_fn = [&](const LeafTask& task, PathStats* sums) {
+        double z[kReductionLeafPaths];
+        double weight[kReductionLeafPaths];
+        {
+            MC_PROFILE_SCOPE(Rng);
+            for (int k = 0; k < task.count; ++k) {
+                const TerminalDriver driver = plan.terminal_driver(static_cast<std::uint64_t>(task.first + k));
+                z[k] = driver.z;
+                weight[k] = driver.weight;
+            }
+        }
+
+        MC_PROFILE_SCOPE(Payoff);
+        for (std::size_t s = task.sum_begin; s < task.sum_end; ++s) {
+            const ScenarioTerminal& t = scenarios[s];
+            for (int k = 0; k < task.count; ++k) {
+                double S_T = t.terminal_price(z[k]);
+                double value = payoff.call ? european_call(S_T, payoff.K) : european_put(S_T, payoff.K);
+                sums[s].add(weight[k] * t.discount * value);
+            }
+        }
+        MC_PROFILE_COUNT(Paths, task.count * static_cast<std::int64_t>(task.sum_end - task.sum_begin));
+    };
+
+    for (const PathStats& total : reduce_leaves(context.threads(), engine.n_paths, scenarios.size(), leaf_fn, true)) {
+        cube.prices.push_back(plan.finish(total));
+    }
+    return cube;
+}
@@ -0,0 +1,180 @@
+#include "stratified_sampling.hpp"
+#include "random_utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// Strata or hypercubes handed to a thread at a time
+const int kScheduleChunk = 4;
+
+// Keyed bijection of [0, n): a Feistel network on the smallest domain of
+// 2 * half bits holding n, walking the cycle until the value falls back
+// into [0, n). Fewer rounds leave the short cycle walks measurably
+// correlated with the identity, and so the step strata with each other.
+const int kFeistelRounds = 8;
+
+class Permutation {
+public:
+    explicit Permutation(std::uint64_t n) : n(n) {
+        int bits = 0;
+        while ((std::uint64_t(1) << bits) < n) {
+            ++bits;
+        }
+        half = (bits + 1) / 2;
+        mask = (std::uint64_t(1) << half) - 1;
+    }
+
+    std::uint64_t operator()(std::uint64_t x, std::uint64_t key) const {
+        do {
+            std::uint64_t left = x >> half;
+            std::uint64_t right = x & mask;
+            for (int round = 0; round < kFeistelRounds; ++round) {
+                std::uint64_t next = left ^ (splitmix64(right ^ (key + round)) & mask);
+                left = right;
+                right = next;
+            }
+            x = (left << half) | right;
+        } while (x >= n);
+        return x;
+    }
+
+private:
+    std::uint64_t n;
+    int half;
+    std::uint64_t mask;
+};
+
+// Step normals of a path whose terminal normal is z_T, filled in with the
+// conditional Brownian bridge in units of sqrt(dt)
+void bridge_normals(double z_T, int steps, RngStream& rng, double* Z) {
+    const double B_n = z_T * std::sqrt(static_cast<double>(steps));
+    double B = 0.0;
+    for (int k = 0; k < steps - 1; ++k) {
+        const double remaining = steps - k;
+        double next = B + (B_n - B) / remaining + std::sqrt((remaining - 1.0) / remaining) * rng.normal();
+        Z[k] = next - B;
+        B = next;
+    }
+    Z[steps - 1] = B_n - B;
+}
+
+// Unbiased sample variance of a set of payoffs
+double sample_variance(const PathStats& stats) {
+    double mean = stats.sum / stats.count;
+    return std::max((stats.sum_sq - mean * stats.sum) / (stats.count - 1), 0.0);
+}
+
+MCResult run_stratified([[maybe_unused]] PricingContext& context, const PricingPlan& plan, std::int64_t H) {
+    const EngineOptions& engine = plan.options();
+    const int steps = plan.params().steps;
+    const std::int64_t base = engine.n_paths / H;
+    const std::int64_t extra = engine.n_paths % H;
+    std::vector<PathStats> strata(static_cast<std::size_t>(H));
+
+#ifdef _OPENMP
+    #pragma omp parallel num_threads(context.threads())
+#endif
+    {
+        std::vector<double> Z(static_cast<std::size_t>(steps));
+
+#ifdef _OPENMP
+        #pragma omp for schedule(dynamic, kScheduleChunk)
+#endif
+        for (std::int64_t h = 0; h < H; ++h) {
+            std::int64_t first = h * base + std::min(h, extra);
+            std::int64_t count = base + (h < extra ? 1 : 0);
+            PathStats stats;
+            for (std::int64_t k = 0; k < count; ++k) {
+                RngStream rng(engine.seed, static_cast<std::uint64_t>(first + k));
+                double z_T = inverse_normal_cdf((h + rng.uniform()) / H);
+                bridge_normals(z_T, steps, rng, Z.data());
+                stats.add(plan.payoff_from_normals(Z.data()));
+            }
+            strata[h] = stats;
+        }
+    }
+
+    // Equiprobable strata: p_h = 1/H
+    double price = 0.0;
+    double variance = 0.0;
+    for (const PathStats& stats : strata) {
+        price += stats.sum / stats.count;
+        variance += sample_variance(stats) / stats.count;
+    }
+
+    MCResult result;
+    result.price = price / H;
+    result.stderr = std::sqrt(variance) / H;
+    return result;
+}
+
+MCResult run_latin_hypercube([[maybe_unused]] PricingContext& context, const PricingPlan& plan, int R) {
+    const EngineOptions& engine = plan.options();
+    const int steps = plan.params().steps;
+    const std::int64_t base = engine.n_paths / R;
+    const std::int64_t extra = engine.n_paths % R;
+    std::vector<double> means(static_cast<std::size_t>(R));
+
+#ifdef _OPENMP
+    #pragma omp parallel num_threads(context.threads())
+#endif
+    {
+        std::vector<double> Z(static_cast<std::size_t>(steps));
+
+#ifdef _OPENMP
+        #pragma omp for schedule(dynamic, 1)
+#endif
+        for (int c = 0; c < R; ++c) {
+            std::int64_t first = c * base + std::min<std::int64_t>(c, extra);
+            std::int64_t m = base + (c < extra ? 1 : 0);
+            Permutation permutation(static_cast<std::uint64_t>(m));
+            const std::uint64_t cube_key = splitmix64(engine.seed ^ splitmix64(static_cast<std::uint64_t>(c)));
+
+            double sum = 0.0;
+            for (std::int64_t k = 0; k < m; ++k) {
+                RngStream rng(engine.seed, static_cast<std::uint64_t>(first + k));
+                for (int j = 0; j < steps; ++j) {
+                    std::uint64_t stratum = permutation(static_cast<std::uint64_t>(k), splitmix64(cube_key + j));
+                    Z[j] = inverse_normal_cdf((stratum + rng.uniform()) / m);
+                }
+                sum += plan.payoff_from_normals(Z.data());
+            }
+            means[c] = sum / m;
+        }
+    }
+
+    // Hypercube means are independent and unbiased
+    double mean = 0.0;
+    for (double x : means) {
+        mean += x;
+    }
+    mean /= R;
+    double spread = 0.0;
+    for (double x : means) {
+        spread += (x - mean) * (x - mean);
+    }
+
+    MCResult result;
+    result.price = mean;
+    result.stderr = std::sqrt(spread / (R * (R - 1.0)));
+    return result;
+}
+
+} // namespace
+
+MCResult stratified_run(PricingContext& context, const PricingPlan& plan, const SamplingOptions& options) {
+    const std::int64_t n_paths = plan.options().n_paths;
+    if (options.scheme == SamplingScheme::Stratified) {
+        if (options.strata <= 0 || n_paths < 2 * options.strata) {
+            throw std::invalid_argument("Stratified sampling needs at least 2 paths per stratum");
+        }
+        return run_stratified(context, plan, options.strata);
+    }
+    if (options.replications < 2 || n_paths < options.replications) {
+        throw std::invalid_argument("Latin hypercube sampling needs at least 2 replications of 1 path");
+    }
+    return run_latin_hypercube(context, plan, options.replications);
+}
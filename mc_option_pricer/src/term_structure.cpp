@@ -0,0 +1,170 @@
+#include "term_structure.hpp"
+#include "black_scholes.hpp"
+#include "payoffs.hpp"
+#include "profiler.hpp"
+#include "random_utils.hpp"
+#include "reduction_tree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+TermCurve TermCurve::flat(double value) {
+    return TermCurve({1.0}, {value}, CurveInterpolation::PiecewiseConstant);
+}
+
+TermCurve TermCurve::piecewise_constant(std::vector<double> times, std::vector<double> values) {
+    if (!times.empty() && times.front() <= 0.0) {
+        throw std::invalid_argument("Piecewise-constant curve times must be positive");
+    }
+    return TermCurve(std::move(times), std::move(values), CurveInterpolation::PiecewiseConstant);
+}
+
+TermCurve TermCurve::linear(std::vector<double> times, std::vector<double> values) {
+    return TermCurve(std::move(times), std::move(values), CurveInterpolation::Linear);
+}
+
+TermCurve::TermCurve(std::vector<double> times, std::vector<double> values, CurveInterpolation interpolation)
+    : times(std::move(times)), values(std::move(values)), interpolation(interpolation) {
+    if (this->times.empty() || this->times.size() != this->values.size()) {
+        throw std::invalid_argument("Curve needs one value per knot and at least one knot");
+    }
+    for (std::size_t i = 0; i < this->times.size(); ++i) {
+        if (!std::isfinite(this->times[i]) || !std::isfinite(this->values[i]) || this->times[i] < 0.0 ||
+            (i > 0 && this->times[i] <= this->times[i - 1])) {
+            throw std::invalid_argument("Curve knots must be finite and strictly increasing");
+        }
+    }
+}
+
+double TermCurve::value(double t) const {
+    // First knot at or after t
+    std::size_t i = static_cast<std::size_t>(std::lower_bound(times.begin(), times.end(), t) - times.begin());
+    if (i == times.size()) {
+        return values.back();
+    }
+    if (interpolation == CurveInterpolation::PiecewiseConstant || i == 0 || t == times[i]) {
+        return values[i];
+    }
+    double w = (t - times[i - 1]) / (times[i] - times[i - 1]);
+    return values[i - 1] + w * (values[i] - values[i - 1]);
+}
+
+double TermCurve::integral(double a, double b) const {
+    double sum;
+    double sum_sq;
+    integrate(a, b, sum, sum_sq);
+    return sum;
+}
+
+double TermCurve::integral_of_square(double a, double b) const {
+    double sum;
+    double sum_sq;
+    integrate(a, b, sum, sum_sq);
+    return sum_sq;
+}
+
+double TermCurve::min_value() const {
+    return *std::min_element(values.begin(), values.end());
+}
+
+void TermCurve::integrate(double a, double b, double& sum, double& sum_sq) const {
+    sum = 0.0;
+    sum_sq = 0.0;
+    // Between consecutive knots the curve is constant or linear, where
+    // int f = h (f_a + f_b) / 2 and int f^2 = h (f_a^2 + f_a f_b + f_b^2) / 3
+    auto knot = std::upper_bound(times.begin(), times.end(), a);
+    double left = a;
+    while (left < b) {
+        double right = b;
+        if (knot != times.end()) {
+            right = std::min(*knot++, b);
+        }
+        double f_a;
+        double f_b;
+        if (interpolation == CurveInterpolation::PiecewiseConstant) {
+            f_a = f_b = value(0.5 * (left + right));
+        } else {
+            f_a = value(left);
+            f_b = value(right);
+        }
+        double h = right - left;
+        sum += h * 0.5 * (f_a + f_b);
+        sum_sq += h * (f_a * f_a + f_a * f_b + f_b * f_b) / 3.0;
+        left = right;
+    }
+}
+
+TermStructurePlan::TermStructurePlan(const TermStructureModel& model, const PayoffSpec& payoff,
+                                     const EngineOptions& options)
+    : S0(model.S0), spec(payoff), engine(options) {
+    // Validate input parameters
+    if (model.S0 <= 0.0) {
+        throw std::invalid_argument("Initial stock price S0 must be positive");
+    }
+    if (model.T <= 0.0) {
+        throw std::invalid_argument("Time to maturity T must be positive");
+    }
+    if (model.steps <= 0) {
+        throw std::invalid_argument("Number of steps must be positive");
+    }
+    if (model.vol.min_value() < 0.0) {
+        throw std::invalid_argument("Volatility curve must be non-negative");
+    }
+    if (model.rate.min_value() < 0.0) {
+        throw std::invalid_argument("Rate curve must be non-negative");
+    }
+    if (payoff.K <= 0.0) {
+        throw std::invalid_argument("Strike price K must be positive");
+    }
+    if (options.n_paths <= 0) {
+        throw std::invalid_argument("Number of paths must be positive");
+    }
+    if (options.drift_shift != 0.0 || options.moment_matching || options.martingale_correction) {
+        throw std::invalid_argument("Term-structure plans do not support drift shift or batch corrections");
+    }
+
+    // Compile the curves into one drift and one diffusion entry per step
+    const double dt = model.T / model.steps;
+    drift.resize(static_cast<std::size_t>(model.steps));
+    diffusion.resize(static_cast<std::size_t>(model.steps));
+    for (int j = 0; j < model.steps; ++j) {
+        const double a = j * dt;
+        const double b = j + 1 == model.steps ? model.T : (j + 1) * dt;
+        const double variance = model.vol.integral_of_square(a, b);
+        drift[static_cast<std::size_t>(j)] = model.rate.integral(a, b) - 0.5 * variance;
+        diffusion[static_cast<std::size_t>(j)] = std::sqrt(variance);
+    }
+    discount = std::exp(-model.rate.integral(0.0, model.T));
+}
+
+MCResult TermStructurePlan::run(PricingContext& context) const {
+    const std::size_t steps = drift.size();
+    const double* drift_row = drift.data();
+    const double* diffusion_row = diffusion.data();
+
+    auto leaf_fn = [&](const LeafTask& task, PathStats* sums) {
+        for (int k = 0; k < task.count; ++k) {
+            RngStream rng(engine.seed, static_cast<std::uint64_t>(task.first + k));
+            double log_price = 0.0;
+            {
+                MC_PROFILE_SCOPE(Step);
+                for (std::size_t j = 0; j < steps; ++j) {
+                    log_price += drift_row[j] + diffusion_row[j] * rng.normal();
+                }
+            }
+            MC_PROFILE_SCOPE(Payoff);
+            double S_T = S0 * std::exp(log_price);
+            double payoff = spec.call ? european_call(S_T, spec.K) : european_put(S_T, spec.K);
+            MC_PROFILE_COUNT(Paths, 1);
+            sums[0].add(discount * payoff);
+        }
+    };
+    return estimate_price(reduce_leaves(context.threads(), engine.n_paths, 1, leaf_fn).front());
+}
+
+double bs_term_structure(const TermStructureModel& model, const PayoffSpec& payoff) {
+    const double r = model.rate.integral(0.0, model.T) / model.T;
+    const double sigma = std::sqrt(model.vol.integral_of_square(0.0, model.T) / model.T);
+    return payoff.call ? bs_call(model.S0, payoff.K, r, sigma, model.T)
+                       : bs_put(model.S0, payoff.K, r, sigma, model.T);
+}
@@ -0,0 +1,142 @@
+#include "unit_path_cache.hpp"
+#include "profiler.hpp"
+#include "reduction_tree.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+// The path set of a plan: its key with spot and strike normalized to 1
+PricingKey unit_key(const PricingPlan& plan) {
+    GBMParams unit = plan.params();
+    unit.S0 = 1.0;
+    return PricingKey::monte_carlo(unit, 1.0, true, plan.options().n_paths, plan.rate(), plan.options().seed);
+}
+
+void check_plan(const PricingPlan& plan) {
+    const EngineOptions& engine = plan.options();
+    if (engine.drift_shift != 0.0 || engine.moment_matching || engine.martingale_correction) {
+        throw std::invalid_argument("Unit path cache needs a plan without drift shift or batch corrections");
+    }
+}
+
+} // namespace
+
+UnitPathCache::UnitPathCache(std::size_t capacity) : max_entries(capacity), counters() {}
+
+MCResult UnitPathCache::price(PricingContext& context, const PricingPlan& plan) {
+    return price(context, plan, std::vector<PayoffSpec>{plan.payoff()}).front();
+}
+
+std::vector<MCResult> UnitPathCache::price(PricingContext& context, const PricingPlan& plan,
+                                           const std::vector<PayoffSpec>& payoffs) {
+    check_plan(plan);
+    for (const PayoffSpec& payoff : payoffs) {
+        if (payoff.K <= 0.0) {
+            throw std::invalid_argument("Strike price K must be positive");
+        }
+    }
+    Growths cached = growths(context, plan);
+    const double* g = cached->data();
+
+    const std::size_t n_payoffs = payoffs.size();
+    const double S0 = plan.params().S0;
+    const double discount = plan.discount_factor();
+
+    auto leaf_fn = [&](const LeafTask& task, PathStats* sums) {
+        MC_PROFILE_SCOPE(Payoff);
+        const double* leaf_g = g + task.first;
+        double values[kReductionLeafPaths];
+
+        for (std::size_t j = 0; j < n_payoffs; ++j) {
+            // european_call/european_put inlined so the pass vectorizes;
+            // the arithmetic is the plan's, so the sums match run()
+            const double K = payoffs[j].K;
+            if (payoffs[j].call) {
+                for (int k = 0; k < task.count; ++k) {
+                    values[k] = discount * std::max(S0 * leaf_g[k] - K, 0.0);
+                }
+            } else {
+                for (int k = 0; k < task.count; ++k) {
+                    values[k] = discount * std::max(K - S0 * leaf_g[k], 0.0);
+                }
+            }
+            for (int k = 0; k < task.count; ++k) {
+                sums[j].add(values[k]);
+            }
+        }
+        MC_PROFILE_COUNT(Paths, task.count * static_cast<std::int64_t>(n_payoffs));
+    };
+
+    std::vector<MCResult> results;
+    for (const PathStats& total : reduce_leaves(context.threads(), plan.options().n_paths, n_payoffs, leaf_fn)) {
+        results.push_back(plan.finish(total));
+    }
+    return results;
+}
+
+UnitPathCache::Growths UnitPathCache::growths([[maybe_unused]] PricingContext& context, const PricingPlan& plan) {
+    PricingKey key = unit_key(plan);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key);
+        if (it != index.end()) {
+            // Move to the front of the LRU list
+            lru.splice(lru.begin(), lru, it->second);
+            ++counters.hits;
+            return it->second->second;
+        }
+        ++counters.misses;
+    }
+
+    // Simulate outside the lock so concurrent misses do not serialize
+    const std::int64_t n_paths = plan.options().n_paths;
+    auto values = std::make_shared<std::vector<double>>(static_cast<std::size_t>(n_paths));
+    double* g = values->data();
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static) num_threads(context.threads())
+#endif
+    for (std::int64_t i = 0; i < n_paths; ++i) {
+        g[i] = plan.terminal_growth(static_cast<std::uint64_t>(i));
+    }
+    Growths result = values;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(key);
+    if (it != index.end()) {
+        lru.splice(lru.begin(), lru, it->second);
+        return it->second->second;
+    }
+    if (max_entries == 0) {
+        return result;
+    }
+    lru.emplace_front(key, result);
+    index[key] = lru.begin();
+    while (lru.size() > max_entries) {
+        index.erase(lru.back().first);
+        lru.pop_back();
+        ++counters.evictions;
+    }
+    return result;
+}
+
+void UnitPathCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    index.clear();
+    lru.clear();
+}
+
+std::size_t UnitPathCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return lru.size();
+}
+
+std::size_t UnitPathCache::capacity() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return max_entries;
+}
+
+CacheStats UnitPathCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
@@ -0,0 +1,192 @@
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/result_cache.hpp"
+#include "../include/pricer.hpp"
+#include "../include/black_scholes.hpp"
+#include "test_util.hpp"
+
+/**
+ * @brief Tests for the pricing result cache
+ *
+ * This test suite verifies:
+ * 1. Canonical keys ignore representation noise but not real differences
+ * 2. Seeded Monte Carlo is reproducible, so it can be cached
+ * 3. Repeated requests hit the cache and return identical results
+ * 4. The LRU policy evicts the least recently used entry
+ * 5. The disk tier serves results to a fresh cache instance
+ * 6. Concurrent writers of one key leave a single, complete entry
+ */
+
+const GBMParams params = {100.0, 0.2, 1.0, 12};
+const double K = 100.0;
+const double r = 0.05;
+const int n_paths = 20000;
+
+TestResult test_canonical_keys() {
+    std::cout << "Testing canonical key hashing..." << std::endl;
+
+    PricingKey a = PricingKey::black_scholes(100.0, 100.0, 0.0, 0.2, 1.0, true);
+    PricingKey b = PricingKey::black_scholes(100.0, 100.0, -0.0, 0.2, 1.0, true);
+    b.seed = 42; // Ignored for closed-form keys
+    b.n_paths = 1000;
+
+    PricingKey c = PricingKey::monte_carlo(params, K, true, n_paths, r, 1);
+    PricingKey d = PricingKey::monte_carlo(params, K, true, n_paths, r, 2);
+    PricingKey e = PricingKey::monte_carlo(params, K, false, n_paths, r, 1);
+
+    GBMParams same = params;
+    GBMParams other = params;
+    other.steps = 13;
+
+    bool passed = a == b && a.hash() == b.hash() &&
+                  !(c == d) && c.hash() != d.hash() &&
+                  !(c == e) &&
+                  hash_gbm_params(params) == hash_gbm_params(same) &&
+                  hash_gbm_params(params) != hash_gbm_params(other);
+    return make_result(passed);
+}
+
+TestResult test_seeded_reproducibility() {
+    std::cout << "Testing seeded Monte Carlo reproducibility..." << std::endl;
+
+    MCResult first = monte_carlo_price(params, K, true, n_paths, r, 7);
+    MCResult second = monte_carlo_price(params, K, true, n_paths, r, 7);
+    MCResult other = monte_carlo_price(params, K, true, n_paths, r, 8);
+
+    double bs_price = bs_call(params.S0, K, r, params.sigma, params.T);
+    bool close = std::abs(first.price - second.price) < 1e-9 &&
+                 std::abs(first.price - bs_price) < 4.0 * first.stderr;
+    return make_result(close && first.price != other.price);
+}
+
+TestResult test_memory_hits() {
+    std::cout << "Testing in-memory hits..." << std::endl;
+
+    ResultCache cache(16);
+    MCResult first = cache.price_monte_carlo(params, K, true, n_paths, r, 11);
+    MCResult second = cache.price_monte_carlo(params, K, true, n_paths, r, 11);
+    double bs_first = cache.price_bs_put(params.S0, K, r, params.sigma, params.T);
+    double bs_second = cache.price_bs_put(params.S0, K, r, params.sigma, params.T);
+
+    CacheStats stats = cache.stats();
+    bool passed = first.price == second.price && first.stderr == second.stderr &&
+                  bs_first == bs_second &&
+                  bs_first == bs_put(params.S0, K, r, params.sigma, params.T) &&
+                  stats.hits == 2 && stats.misses == 2 && cache.size() == 2;
+    return make_result(passed);
+}
+
+TestResult test_lru_eviction() {
+    std::cout << "Testing LRU eviction..." << std::endl;
+
+    ResultCache cache(2);
+    cache.price_bs_call(100.0, 90.0, r, 0.2, 1.0);
+    cache.price_bs_call(100.0, 100.0, r, 0.2, 1.0);
+    cache.price_bs_call(100.0, 90.0, r, 0.2, 1.0);   // Refresh K=90
+    cache.price_bs_call(100.0, 110.0, r, 0.2, 1.0);  // Evicts K=100
+
+    MCResult out;
+    bool kept = cache.lookup(PricingKey::black_scholes(100.0, 90.0, r, 0.2, 1.0, true), out);
+    bool evicted = !cache.lookup(PricingKey::black_scholes(100.0, 100.0, r, 0.2, 1.0, true), out);
+
+    CacheStats stats = cache.stats();
+    return make_result(kept && evicted && stats.evictions == 1 && cache.size() == 2);
+}
+
+TestResult test_disk_tier() {
+    std::cout << "Testing on-disk persistence..." << std::endl;
+
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "mc_result_cache_test";
+    std::filesystem::remove_all(dir);
+
+    MCResult written;
+    {
+        ResultCache writer(4, dir.string());
+        written = writer.price_monte_carlo(params, K, false, n_paths, r, 3);
+    }
+
+    ResultCache reader(4, dir.string());
+    MCResult read = reader.price_monte_carlo(params, K, false, n_paths, r, 3);
+    CacheStats stats = reader.stats();
+
+    bool passed = read.price == written.price && read.stderr == written.stderr &&
+                  stats.disk_hits == 1 && stats.misses == 0;
+    std::filesystem::remove_all(dir);
+    return make_result(passed);
+}
+
+TestResult test_concurrent_disk_writers() {
+    std::cout << "Testing concurrent disk writers..." << std::endl;
+
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "mc_result_cache_writers";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    // Separate instances stand in for separate processes sharing the directory
+    const PricingKey key = PricingKey::monte_carlo(params, K, true, n_paths, r, 11);
+    const MCResult value = {10.25, 0.125};
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 4; ++w) {
+        writers.emplace_back([&dir, &key, &value]() {
+            ResultCache cache(4, dir.string());
+            for (int i = 0; i < 200; ++i) {
+                cache.store(key, value);
+            }
+        });
+    }
+    for (std::thread& writer : writers) {
+        writer.join();
+    }
+
+    ResultCache reader(4, dir.string());
+    MCResult read;
+    bool found = reader.lookup(key, read);
+    std::size_t files = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+        (void)entry;
+        ++files;
+    }
+
+    bool passed = found && read.price == value.price && read.stderr == value.stderr &&
+                  reader.stats().disk_hits == 1 && files == 1;
+    std::filesystem::remove_all(dir);
+    return make_result(passed);
+}
+
+int main() {
+    std::cout << "Result Cache Test Suite" << std::endl;
+    std::cout << "=======================" << std::endl;
+    std::cout << std::endl;
+
+    TestResult keys_test = test_canonical_keys();
+    TestResult seeded_test = test_seeded_reproducibility();
+    TestResult memory_test = test_memory_hits();
+    TestResult lru_test = test_lru_eviction();
+    TestResult disk_test = test_disk_tier();
+    TestResult writers_test = test_concurrent_disk_writers();
+
+    std::cout << std::endl;
+    print_test_result("Canonical Keys", keys_test);
+    print_test_result("Seeded Reproducibility", seeded_test);
+    print_test_result("Memory Hits", memory_test);
+    print_test_result("LRU Eviction", lru_test);
+    print_test_result("Disk Tier", disk_test);
+    print_test_result("Concurrent Disk Writers", writers_test);
+
+    int total_tests = 6;
+    int passed_tests = (keys_test.passed ? 1 : 0) +
+                       (seeded_test.passed ? 1 : 0) +
+                       (memory_test.passed ? 1 : 0) +
+                       (lru_test.passed ? 1 : 0) +
+                       (disk_test.passed ? 1 : 0) +
+                       (writers_test.passed ? 1 : 0);
+
+    std::cout << std::endl;
+    std::cout << "Passed: " << passed_tests << "/" << total_tests << std::endl;
+    return passed_tests == total_tests ? 0 : 1;
+}
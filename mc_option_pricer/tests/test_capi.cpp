@@ -0,0 +1,170 @@
+#include <iostream>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "../include/mcpricer.h"
+#include "test_util.hpp"
+
+/**
+ * @brief Tests for the libmcpricer C ABI
+ *
+ * Only mcpricer.h is included and the test links the shared library, so
+ * this exercises exactly what an external caller sees.
+ *
+ * This test suite verifies:
+ * 1. Context lifecycle, version and NULL handling
+ * 2. Batch pricing matches single calls and the Black-Scholes batch
+ * 3. Invalid options are reported per element without aborting the batch
+ * 4. Context seed sequences are reproducible
+ */
+
+TestResult test_context_lifecycle() {
+    std::cout << "Testing context lifecycle..." << std::endl;
+
+    mcp_context* context = nullptr;
+    bool passed = mcp_abi_version() == MCPRICER_ABI_VERSION &&
+                  mcp_context_create(2, 1, nullptr) == MCP_NULL_POINTER &&
+                  mcp_context_create(-1, 1, &context) == MCP_INVALID_ARGUMENT &&
+                  context == nullptr &&
+                  mcp_context_create(2, 1, &context) == MCP_OK &&
+                  context != nullptr &&
+                  mcp_context_threads(context) == 2 &&
+                  std::strcmp(mcp_context_last_error(context), "") == 0 &&
+                  std::strcmp(mcp_status_string(MCP_OK), "ok") == 0;
+
+    double price = 0.0;
+    double std_error = 0.0;
+    passed = passed &&
+             mcp_price_european(nullptr, 100, 100, 0.05, 0.2, 1, 12, 100, 1, 1, &price, &std_error) == MCP_NULL_POINTER &&
+             mcp_price_european(context, 100, 100, 0.05, 0.2, 1, 12, 100, 1, 1, nullptr, &std_error) == MCP_NULL_POINTER;
+
+    mcp_context_destroy(context);
+    mcp_context_destroy(nullptr);
+    return make_result(passed);
+}
+
+TestResult test_batch_pricing() {
+    std::cout << "Testing batch pricing..." << std::endl;
+
+    const size_t n = 4;
+    std::vector<double> S0 = {100.0, 100.0, 90.0, 110.0};
+    std::vector<double> K = {100.0, 100.0, 95.0, 105.0};
+    std::vector<double> r = {0.05, 0.05, 0.03, 0.01};
+    std::vector<double> sigma = {0.2, 0.2, 0.3, 0.15};
+    std::vector<double> T = {1.0, 1.0, 0.5, 2.0};
+    std::vector<int32_t> steps = {52, 52, 26, 12};
+    std::vector<int64_t> n_paths = {40000, 40000, 40000, 40000};
+    std::vector<int32_t> is_call = {1, 0, 1, 0};
+    std::vector<uint64_t> seeds = {11, 12, 13, 14};
+
+    mcp_context* context = nullptr;
+    mcp_context_create(1, 7, &context);
+
+    std::vector<double> price(n), std_error(n), bs(n);
+    std::vector<int32_t> status(n, -1);
+    bool passed = mcp_price_european_batch(context, n, S0.data(), K.data(), r.data(), sigma.data(),
+                                           T.data(), steps.data(), n_paths.data(), is_call.data(),
+                                           seeds.data(), price.data(), std_error.data(),
+                                           status.data()) == MCP_OK &&
+                  mcp_black_scholes_batch(n, S0.data(), K.data(), r.data(), sigma.data(), T.data(),
+                                          is_call.data(), bs.data(), nullptr) == MCP_OK;
+
+    for (size_t i = 0; i < n && passed; ++i) {
+        double single = 0.0;
+        double single_error = 0.0;
+        passed = mcp_price_european(context, S0[i], K[i], r[i], sigma[i], T[i], steps[i], n_paths[i],
+                                    is_call[i], seeds[i], &single, &single_error) == MCP_OK &&
+                 status[i] == MCP_OK &&
+                 single == price[i] && single_error == std_error[i] &&
+                 std::abs(price[i] - bs[i]) < 4.0 * std_error[i];
+    }
+
+    mcp_context_destroy(context);
+    return make_result(passed);
+}
+
+TestResult test_batch_errors() {
+    std::cout << "Testing per-option errors..." << std::endl;
+
+    const size_t n = 3;
+    double S0[] = {100.0, -1.0, 100.0};
+    double K[] = {100.0, 100.0, NAN};
+    double r[] = {0.05, 0.05, 0.05};
+    double sigma[] = {0.2, 0.2, 0.2};
+    double T[] = {1.0, 1.0, 1.0};
+    int32_t steps[] = {4, 4, 4};
+    int64_t n_paths[] = {1000, 1000, 1000};
+    int32_t is_call[] = {1, 1, 1};
+    double price[n];
+    int32_t status[n];
+
+    mcp_context* context = nullptr;
+    mcp_context_create(1, 7, &context);
+
+    mcp_status result = mcp_price_european_batch(context, n, S0, K, r, sigma, T, steps, n_paths,
+                                                 is_call, nullptr, price, nullptr, status);
+    bool passed = result == MCP_INVALID_ARGUMENT &&
+                  status[0] == MCP_OK && std::isfinite(price[0]) &&
+                  status[1] == MCP_INVALID_ARGUMENT && std::isnan(price[1]) &&
+                  status[2] == MCP_INVALID_ARGUMENT && std::isnan(price[2]) &&
+                  std::strlen(mcp_context_last_error(context)) > 0 &&
+                  mcp_price_european_batch(context, n, S0, K, r, sigma, T, steps, nullptr,
+                                           is_call, nullptr, price, nullptr, status) == MCP_NULL_POINTER;
+
+    mcp_context_destroy(context);
+    return make_result(passed);
+}
+
+TestResult test_context_seed_sequence() {
+    std::cout << "Testing context seed sequences..." << std::endl;
+
+    double S0[] = {100.0, 100.0};
+    double K[] = {100.0, 100.0};
+    double r[] = {0.05, 0.05};
+    double sigma[] = {0.2, 0.2};
+    double T[] = {1.0, 1.0};
+    int32_t steps[] = {12, 12};
+    int64_t n_paths[] = {5000, 5000};
+    int32_t is_call[] = {1, 1};
+    double a[2], b[2];
+
+    mcp_context* first = nullptr;
+    mcp_context* second = nullptr;
+    mcp_context_create(1, 2024, &first);
+    mcp_context_create(2, 2024, &second);
+    mcp_price_european_batch(first, 2, S0, K, r, sigma, T, steps, n_paths, is_call, nullptr, a, nullptr, nullptr);
+    mcp_price_european_batch(second, 2, S0, K, r, sigma, T, steps, n_paths, is_call, nullptr, b, nullptr, nullptr);
+    mcp_context_destroy(first);
+    mcp_context_destroy(second);
+
+    // Same sequence across contexts, fresh seed for each option
+    bool passed = std::abs(a[0] - b[0]) < 1e-12 * a[0] &&
+                  std::abs(a[1] - b[1]) < 1e-12 * a[1] &&
+                  a[0] != a[1];
+    return make_result(passed);
+}
+
+int main() {
+    std::cout << "C ABI Test Suite" << std::endl;
+    std::cout << "================" << std::endl;
+    std::cout << std::endl;
+
+    std::vector<std::pair<std::string, TestResult>> results;
+    results.emplace_back("Context Lifecycle", test_context_lifecycle());
+    results.emplace_back("Batch Pricing", test_batch_pricing());
+    results.emplace_back("Batch Errors", test_batch_errors());
+    results.emplace_back("Context Seed Sequence", test_context_seed_sequence());
+
+    std::cout << std::endl;
+    int passed_tests = 0;
+    for (const auto& entry : results) {
+        print_test_result(entry.first, entry.second);
+        passed_tests += entry.second.passed ? 1 : 0;
+    }
+
+    int total_tests = static_cast<int>(results.size());
+    std::cout << std::endl;
+    std::cout << "Passed: " << passed_tests << "/" << total_tests << std::endl;
+    return passed_tests == total_tests ? 0 : 1;
+}
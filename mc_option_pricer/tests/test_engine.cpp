@@ -0,0 +1,585 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/chunked_run.hpp"
+#include "../include/pricing_context.hpp"
+#include "../include/pricing_plan.hpp"
+#include "../include/reduction_tree.hpp"
+#include "../include/pricer.hpp"
+#include "../include/black_scholes.hpp"
+#include "../include/payoffs.hpp"
+#include "../include/random_utils.hpp"
+#include "test_util.hpp"
+
+/**
+ * @brief Tests for the Monte Carlo engine internals
+ *
+ * This test suite verifies:
+ * 1. PricingPlan rejects invalid inputs at construction
+ * 2. A plan can be run repeatedly with the same result
+ * 3. The plan reproduces a reference loop built on simulate_path()
+ * 4. PricingContext reproduces run() with its own thread budget
+ * 5. Concurrent contexts do not interfere with each other
+ * 6. Path ranges shard and merge back into run()
+ * 7. Path indices beyond 2^31 and 2^32 address distinct streams
+ * 8. A checkpointed, resumed run reproduces an uninterrupted one exactly
+ * 9. Checkpoints of a different valuation are rejected
+ * 10. A chunked run returns the bits of run(), for any chunk size
+ * 11. Progress records track the run and end at the final estimate
+ * 12. Cancellation stops at a chunk boundary with an exact partial estimate
+ * 13. Deadlines stop the run with bounded overshoot
+ * 14. Estimates are bit-identical for any thread count
+ * 15. Moment matching stays accurate and reports a smaller, honest error
+ * 16. Martingale correction reprices the forward, so put-call parity is exact
+ * 17. Corrected plans need two batches and use the unbiased batch error
+ */
+
+const GBMParams params = {100.0, 0.2, 1.0, 52};
+const double K = 100.0;
+const double r = 0.05;
+
+bool rejects(const GBMParams& p, double rate, const PayoffSpec& payoff, const EngineOptions& options) {
+    try {
+        PricingPlan plan(p, rate, payoff, options);
+    } catch (const std::invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+TestResult test_plan_validation() {
+    std::cout << "Testing plan validation..." << std::endl;
+
+    EngineOptions options = {1000, 1};
+    PayoffSpec payoff = {K, true};
+    GBMParams bad_s0 = {-1.0, 0.2, 1.0, 52};
+    GBMParams bad_sigma = {100.0, -0.2, 1.0, 52};
+    GBMParams bad_T = {100.0, 0.2, 0.0, 52};
+    GBMParams bad_steps = {100.0, 0.2, 1.0, 0};
+
+    bool passed = rejects(bad_s0, r, payoff, options) &&
+                  rejects(bad_sigma, r, payoff, options) &&
+                  rejects(bad_T, r, payoff, options) &&
+                  rejects(bad_steps, r, payoff, options) &&
+                  rejects(params, -0.01, payoff, options) &&
+                  rejects(params, r, PayoffSpec{0.0, true}, options) &&
+                  rejects(params, r, payoff, EngineOptions{0, 1}) &&
+                  !rejects(params, r, payoff, options);
+    return make_result(passed);
+}
+
+TestResult test_plan_reuse() {
+    std::cout << "Testing repeated plan runs..." << std::endl;
+
+    PricingPlan plan(params, r, PayoffSpec{K, false}, EngineOptions{50000, 5});
+    MCResult first = plan.run();
+    MCResult second = plan.run();
+
+    double bs_price = bs_put(params.S0, K, r, params.sigma, params.T);
+    bool passed = std::abs(first.price - second.price) <= 1e-12 * first.price &&
+                  std::abs(first.price - bs_price) < 4.0 * first.stderr &&
+                  plan.dt() == params.T / params.steps;
+    return make_result(passed);
+}
+
+TestResult test_plan_matches_reference() {
+    std::cout << "Testing plan against simulate_path reference..." << std::endl;
+
+    const int n_paths = 2000;
+    const std::uint64_t seed = 17;
+    PricingPlan plan(params, r, PayoffSpec{K, true}, EngineOptions{n_paths, seed});
+    MCResult planned = plan.run();
+
+    // Same streams, multiplicative stepping through simulate_path()
+    double total = 0.0;
+    for (int i = 0; i < n_paths; ++i) {
+        RngStream rng(seed, static_cast<std::uint64_t>(i));
+        std::vector<double> path = simulate_path(params, r, rng);
+        total += std::exp(-r * params.T) * european_call(path.back(), K);
+    }
+    double reference = total / n_paths;
+
+    return make_result(std::abs(planned.price - reference) < 1e-9 * reference);
+}
+
+TestResult test_context_matches_plan() {
+    std::cout << "Testing context runs against plan runs..." << std::endl;
+
+    PricingPlan plan(params, r, PayoffSpec{K, true}, EngineOptions{20000, 3});
+    MCResult planned = plan.run();
+
+    PricingContext single(1, 99);
+    PricingContext multi(4, 99);
+    MCResult a = single.run(plan);
+    MCResult b = multi.run(plan);
+
+    bool passed = a.price == planned.price && b.price == planned.price &&
+                  a.stderr == planned.stderr && b.stderr == planned.stderr &&
+                  single.threads() == 1 && multi.threads() == 4 &&
+                  single.stats().runs == 1 && single.stats().paths == 20000 &&
+                  single.stats().path_steps == 20000ULL * params.steps;
+
+    // Seed sequences are per context and reproducible
+    PricingContext again(1, 99);
+    passed = passed && again.next_seed() == PricingContext(4, 99).next_seed();
+    return make_result(passed);
+}
+
+TestResult test_concurrent_contexts() {
+    std::cout << "Testing concurrent contexts..." << std::endl;
+
+    const int n_callers = 4;
+    std::vector<MCResult> expected(n_callers);
+    for (int c = 0; c < n_callers; ++c) {
+        PricingContext context(1 + c % 2, 1000 + c);
+        expected[c] = context.price(params, K + c, c % 2 == 0, 10000, r);
+    }
+
+    std::vector<MCResult> concurrent(n_callers);
+    std::vector<std::thread> callers;
+    for (int c = 0; c < n_callers; ++c) {
+        callers.emplace_back([&concurrent, c]() {
+            PricingContext context(1 + c % 2, 1000 + c);
+            concurrent[c] = context.price(params, K + c, c % 2 == 0, 10000, r);
+        });
+    }
+    for (std::thread& caller : callers) {
+        caller.join();
+    }
+
+    bool passed = true;
+    for (int c = 0; c < n_callers; ++c) {
+        passed = passed && std::abs(concurrent[c].price - expected[c].price) < 1e-12 * expected[c].price;
+    }
+    return make_result(passed);
+}
+
+TestResult test_range_sharding() {
+    std::cout << "Testing sharded path ranges..." << std::endl;
+
+    PricingPlan plan(params, r, PayoffSpec{K, false}, EngineOptions{30000, 21});
+    MCResult whole = plan.run();
+
+    // Uneven shards, merged out of order
+    PathStats merged = plan.run_range(17000, 13000);
+    merged.merge(plan.run_range(0, 5000));
+    PricingContext context(2, 1);
+    merged.merge(context.run_range(plan, 5000, 12000));
+    MCResult sharded = plan.finish(merged);
+
+    bool passed = merged.count == 30000 &&
+                  std::abs(sharded.price - whole.price) < 1e-12 * whole.price &&
+                  std::abs(sharded.stderr - whole.stderr) < 1e-9 * whole.stderr &&
+                  context.stats().paths == 12000;
+    return make_result(passed);
+}
+
+TestResult test_large_path_offsets() {
+    std::cout << "Testing path offsets above 2^31..." << std::endl;
+
+    // A plan sized past INT_MAX and UINT32_MAX is valid; only a few of
+    // its paths are simulated here (see test_long_run for a full run)
+    const std::int64_t n_paths = (1LL << 32) + 1000;
+    PricingPlan plan(params, r, PayoffSpec{K, true}, EngineOptions{n_paths, 8});
+
+    const std::uint64_t first = (1ULL << 31) - 100;  // Straddles 2^31
+    PathStats merged = plan.run_range(first, 1000);
+    merged.merge(plan.run_range(first + 1000, 1000));
+
+    PathStats serial;
+    for (std::uint64_t i = 0; i < 2000; ++i) {
+        serial.add(plan.path_payoff(first + i));
+    }
+
+    // Streams 2^32 + i must not alias stream i through 32-bit truncation
+    bool distinct = true;
+    for (std::uint64_t i = 0; i < 16; ++i) {
+        double low = plan.path_payoff(i);
+        double high = plan.path_payoff((1ULL << 32) + i);
+        distinct = distinct && (low != high || low == 0.0);
+    }
+
+    bool passed = merged.count == 2000 && serial.count == 2000 &&
+                  std::abs(merged.sum - serial.sum) < 1e-9 * serial.sum &&
+                  std::abs(merged.sum_sq - serial.sum_sq) < 1e-9 * serial.sum_sq &&
+                  distinct && plan.options().n_paths == n_paths;
+    return make_result(passed);
+}
+
+std::string temp_file(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+TestResult test_checkpoint_resume() {
+    std::cout << "Testing checkpoint and resume..." << std::endl;
+
+    const std::string file = temp_file("mc_test_engine.ckpt");
+    PricingPlan plan(params, r, PayoffSpec{K, true}, EngineOptions{50000, 77});
+    PricingContext context(2, 1);
+
+    ChunkedRun uninterrupted(plan, 4096);
+    MCResult expected = uninterrupted.run(context);
+
+    // "Crash" after three chunks, then continue in a fresh run object
+    ChunkedRun first(plan, 4096);
+    for (int c = 0; c < 3; ++c) {
+        first.run_chunk(context);
+    }
+    first.save_checkpoint(file);
+
+    ChunkedRun resumed(plan, 4096);
+    bool loaded = resumed.resume(file);
+    bool position_ok = resumed.next_path() == 3 * 4096;
+    MCResult actual = resumed.run(context);
+
+    bool missing = !ChunkedRun(plan, 4096).resume(temp_file("mc_test_engine_missing.ckpt"));
+
+    // Chunk sums do not depend on the thread count, so another machine
+    // can finish the run with the same bits
+    PricingContext other(3, 1);
+    ChunkedRun moved(plan, 4096);
+    moved.resume(file);
+    MCResult moved_result = moved.run(other);
+    std::remove(file.c_str());
+
+    bool passed = loaded && position_ok && missing &&
+                  actual.price == expected.price && actual.stderr == expected.stderr &&
+                  moved_result.price == expected.price && moved_result.stderr == expected.stderr &&
+                  resumed.done() && resumed.stats().count == 50000;
+    return make_result(passed);
+}
+
+TestResult test_checkpoint_mismatch() {
+    std::cout << "Testing checkpoint validation..." << std::endl;
+
+    const std::string file = temp_file("mc_test_engine_mismatch.ckpt");
+    PricingPlan plan(params, r, PayoffSpec{K, true}, EngineOptions{10000, 5});
+    PricingPlan other_seed(params, r, PayoffSpec{K, true}, EngineOptions{10000, 6});
+    PricingContext context(1, 1);
+
+    ChunkedRun run(plan, 1024);
+    run.run_chunk(context);
+    run.save_checkpoint(file);
+
+    auto rejected = [&file](const PricingPlan& p, std::int64_t chunk) {
+        try {
+            ChunkedRun attempt(p, chunk);
+            attempt.resume(file);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    bool passed = rejected(other_seed, 1024) && rejected(plan, 2048) && !rejected(plan, 1024);
+
+    // Truncated file
+    std::FILE* out = std::fopen(file.c_str(), "wb");
+    std::fputs("MCCK", out);
+    std::fclose(out);
+    passed = passed && rejected(plan, 1024);
+    std::remove(file.c_str());
+    return make_result(passed);
+}
+
+TestResult test_chunked_matches_run() {
+    std::cout << "Testing chunked runs against run()..." << std::endl;
+
+    PricingContext serial(1, 1);
+    PricingContext parallel(3, 1);
+    bool passed = true;
+    for (std::uint64_t seed = 1; seed <= 10; ++seed) {
+        PricingPlan plan(params, r, PayoffSpec{K, true}, EngineOptions{30000, seed});
+        MCResult expected = serial.run(plan);
+        MCResult whole = plan.run();
+        for (std::int64_t chunk : {std::int64_t(256), std::int64_t(1024), std::int64_t(4096), kDefaultChunkPaths}) {
+            MCResult chunked = ChunkedRun(plan, chunk).run(seed % 2 == 0 ? serial : parallel);
+            passed = passed && chunked.price == expected.price && chunked.stderr == expected.stderr;
+        }
+        passed = passed && whole.price == expected.price && whole.stderr == expected.stderr;
+    }
+
+    // Batch-corrected plans reduce over batches of kCorrectionBatchPaths
+    EngineOptions corrected{50000, 12};
+    corrected.moment_matching = true;
+    PricingPlan batched(params, r, PayoffSpec{K, true}, corrected);
+    MCResult batched_expected = serial.run(batched);
+    MCResult batched_chunked = ChunkedRun(batched, 2 * kCorrectionBatchPaths).run(parallel);
+    passed = passed && batched_chunked.price == batched_expected.price &&
+             batched_chunked.stderr == batched_expected.stderr;
+
+    // Chunks that are not a power-of-two number of leaves are rejected
+    auto rejected = [](const PricingPlan& p, std::int64_t chunk) {
+        try {
+            ChunkedRun run(p, chunk);
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+    PricingPlan plan(params, r, PayoffSpec{K, true}, EngineOptions{30000, 1});
+    passed = passed && rejected(plan, 0) && rejected(plan, 1000) && rejected(plan, 768) &&
+             rejected(batched, 1024) && !rejected(batched, kCorrectionBatchPaths);
+    return make_result(passed);
+}
+
+TestResult test_progress_records() {
+    std::cout << "Testing progress records..." << std::endl;
+
+    PricingPlan plan(params, r, PayoffSpec{K, false}, EngineOptions{10000, 4});
+    PricingContext context(2, 1);
+    ChunkedRun run(plan, 1024);
+
+    std::vector<ProgressRecord> records;
+    run.set_progress([&records](const ProgressRecord& record) { records.push_back(record); }, 0.0);
+    MCResult result = run.run(context);
+
+    // Interval 0: one record per chunk, the last one after the final chunk
+    bool passed = records.size() == 10 &&
+                  records.back().paths_done == 10000 &&
+                  records.back().price == result.price &&
+                  records.back().stderr == result.stderr &&
+                  records.back().eta_seconds == 0.0;
+    for (std::size_t i = 1; i < records.size(); ++i) {
+        passed = passed && records[i].paths_done > records[i - 1].paths_done &&
+                 records[i].n_paths == 10000 && records[i].stderr > 0.0;
+    }
+    return make_result(passed);
+}
+
+TestResult test_cancellation() {
+    std::cout << "Testing cancellation..." << std::endl;
+
+    PricingPlan plan(params, r, PayoffSpec{K, true}, EngineOptions{20000, 6});
+    PricingContext context(2, 1);
+
+    CancellationToken early;
+    early.cancel();
+    RunLimits cancelled_limits;
+    cancelled_limits.cancel = &early;
+    ChunkedRun never(plan, 2048);
+    BoundedResult none = never.run_until(context, cancelled_limits);
+
+    // Cancel from the progress callback once three chunks are merged
+    CancellationToken token;
+    ChunkedRun run(plan, 2048);
+    run.set_progress([&token](const ProgressRecord& record) {
+        if (record.paths_done >= 3 * 2048) {
+            token.cancel();
+        }
+    }, 0.0);
+    RunLimits limits;
+    limits.cancel = &token;
+    BoundedResult partial = run.run_until(context, limits);
+
+    ChunkedRun reference(plan, 2048);
+    for (int c = 0; c < 3; ++c) {
+        reference.run_chunk(context);
+    }
+
+    // A stopped run continues to the uninterrupted result
+    MCResult finished = run.run(context);
+    MCResult expected = ChunkedRun(plan, 2048).run(context);
+
+    bool passed = none.reason == StopReason::Cancelled && none.paths_completed == 0 &&
+                  std::isnan(none.estimate.price) &&
+                  partial.reason == StopReason::Cancelled && partial.paths_completed == 3 * 2048 &&
+                  partial.estimate.price == reference.result().price &&
+                  partial.estimate.stderr == reference.result().stderr &&
+                  finished.price == expected.price;
+    return make_result(passed);
+}
+
+TestResult test_deadline() {
+    std::cout << "Testing deadlines..." << std::endl;
+    using clock = std::chrono::steady_clock;
+
+    // Far more paths than fit in the budget
+    PricingPlan plan(params, r, PayoffSpec{K, true}, EngineOptions{1LL << 40, 2});
+    PricingContext context(1, 1);
+
+    RunLimits expired;
+    expired.deadline = clock::now();
+    BoundedResult none = ChunkedRun(plan, 1024).run_until(context, expired);
+
+    const double budget = 0.2;
+    RunLimits limits;
+    clock::time_point start = clock::now();
+    limits.deadline = start + std::chrono::milliseconds(200);
+    ChunkedRun run(plan, 1024);
+    BoundedResult bounded = run.run_until(context, limits);
+    double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+
+    double bs_price = bs_call(params.S0, K, r, params.sigma, params.T);
+    bool passed = none.reason == StopReason::Deadline && none.paths_completed == 0 &&
+                  bounded.reason == StopReason::Deadline &&
+                  bounded.paths_completed > 0 && bounded.paths_completed % 1024 == 0 &&
+                  elapsed < budget + 0.05 &&
+                  std::abs(bounded.estimate.price - bs_price) < 5.0 * bounded.estimate.stderr;
+    std::cout << "  " << bounded.paths_completed << " paths in " << elapsed << " s" << std::endl;
+    return make_result(passed);
+}
+
+TestResult test_thread_count_independence() {
+    std::cout << "Testing thread-count independence..." << std::endl;
+
+    // Not a multiple of the leaf size, so the last leaf is partial
+    PricingPlan plan(params, r, PayoffSpec{K, false}, EngineOptions{40000 + 77, 12});
+    PathStats reference = PricingContext(1, 1).run_range(plan, 0, plan.options().n_paths);
+
+    bool passed = true;
+    for (int threads : {2, 3, 5, 8}) {
+        PathStats stats = PricingContext(threads, 1).run_range(plan, 0, plan.options().n_paths);
+        passed = passed && stats.count == reference.count && stats.sum == reference.sum &&
+                 stats.sum_sq == reference.sum_sq;
+    }
+
+    // Trees built over arbitrary contiguous splits of the leaves append
+    // to the canonical tree
+    std::vector<PathStats> leaves;
+    for (std::int64_t first = 0; first < plan.options().n_paths; first += kReductionLeafPaths) {
+        leaves.push_back(plan.sum_paths(static_cast<std::uint64_t>(first),
+                                        std::min(kReductionLeafPaths, plan.options().n_paths - first)));
+    }
+    const std::int64_t n_leaves = static_cast<std::int64_t>(leaves.size());
+    for (std::int64_t split : {std::int64_t(1), std::int64_t(37), std::int64_t(64), n_leaves - 1}) {
+        ReductionTree head;
+        ReductionTree tail;
+        for (std::int64_t leaf = 0; leaf < n_leaves; ++leaf) {
+            (leaf < split ? head : tail).add_leaf(leaf, leaves[leaf]);
+        }
+        head.append(tail);
+        PathStats stats = head.total();
+        passed = passed && stats.sum == reference.sum && stats.sum_sq == reference.sum_sq;
+    }
+    return make_result(passed);
+}
+
+TestResult test_moment_matching() {
+    std::cout << "Testing moment matching..." << std::endl;
+
+    PricingContext context(2, 1);
+    EngineOptions options{200000, 21};
+    options.moment_matching = true;
+    MCResult plain = context.run(PricingPlan(params, r, PayoffSpec{K, true}, EngineOptions{200000, 21}));
+    MCResult matched = context.run(PricingPlan(params, r, PayoffSpec{K, true}, options));
+    double bs_price = bs_call(params.S0, K, r, params.sigma, params.T);
+    std::cout << "  " << matched.price << " +/- " << matched.stderr << " (plain +/- " << plain.stderr
+              << ")" << std::endl;
+
+    // Batch means of independent seeds against the reported error
+    const int n_seeds = 20;
+    double spread = 0.0;
+    double reported = 0.0;
+    for (int seed = 0; seed < n_seeds; ++seed) {
+        EngineOptions small{20000, static_cast<std::uint64_t>(100 + seed)};
+        small.moment_matching = true;
+        MCResult result = context.run(PricingPlan(params, r, PayoffSpec{K, true}, small));
+        spread += (result.price - bs_price) * (result.price - bs_price) / n_seeds;
+        reported += result.stderr / n_seeds;
+    }
+    double empirical = std::sqrt(spread);
+    std::cout << "  reported " << reported << ", empirical " << empirical << std::endl;
+
+    bool passed = std::abs(matched.price - bs_price) < 4.0 * matched.stderr &&
+                  matched.stderr < 0.25 * plain.stderr &&
+                  empirical > 0.5 * reported && empirical < 2.0 * reported;
+    return make_result(passed);
+}
+
+TestResult test_martingale_correction() {
+    std::cout << "Testing martingale correction..." << std::endl;
+
+    // Not a multiple of the batch size, so the last batch is partial
+    EngineOptions options{100000 + 77, 22};
+    options.martingale_correction = true;
+    PricingPlan call(params, r, PayoffSpec{K, true}, options);
+    PricingPlan put(params, r, PayoffSpec{K, false}, options);
+    MCResult call_result = PricingContext(1, 1).run(call);
+    MCResult put_result = PricingContext(1, 1).run(put);
+
+    // Every batch reprices the forward, so C - P = S0 - K exp(-rT) per batch
+    double parity = params.S0 - K * std::exp(-r * params.T);
+    double bs_price = bs_call(params.S0, K, r, params.sigma, params.T);
+    std::cout << "  call " << call_result.price << " +/- " << call_result.stderr
+              << ", parity error " << call_result.price - put_result.price - parity << std::endl;
+
+    MCResult threaded = PricingContext(3, 1).run(call);
+    MCResult planned = call.run();
+    bool passed = std::abs(call_result.price - put_result.price - parity) < 1e-10 * params.S0 &&
+                  std::abs(call_result.price - bs_price) < 4.0 * call_result.stderr &&
+                  threaded.price == call_result.price && threaded.stderr == call_result.stderr &&
+                  planned.price == call_result.price && planned.stderr == call_result.stderr;
+    return make_result(passed);
+}
+
+TestResult test_correction_batch_count() {
+    std::cout << "Testing the batch count of corrected plans..." << std::endl;
+
+    // One batch has no spread to estimate the error from
+    bool passed = false;
+    EngineOptions one_batch{kCorrectionBatchPaths, 31};
+    one_batch.moment_matching = true;
+    try {
+        PricingPlan plan(params, r, PayoffSpec{K, true}, one_batch);
+    } catch (const std::invalid_argument&) {
+        passed = true;
+    }
+
+    // Two batches: the error is the sample deviation of the two batch means
+    // over sqrt(2), which is half their difference
+    EngineOptions two_batches{2 * kCorrectionBatchPaths, 31};
+    two_batches.martingale_correction = true;
+    PricingPlan plan(params, r, PayoffSpec{K, true}, two_batches);
+    MCResult result = plan.run();
+    PathStats first = plan.sum_paths(0, kCorrectionBatchPaths);
+    PathStats second = plan.sum_paths(kCorrectionBatchPaths, kCorrectionBatchPaths);
+    double expected = 0.5 * std::abs(first.sum / first.count - second.sum / second.count);
+    std::cout << "  two batches: +/- " << result.stderr << " (expected " << expected << ")" << std::endl;
+
+    passed = passed && result.stderr > 0.0 && std::abs(result.stderr - expected) < 1e-12 * expected;
+    return make_result(passed);
+}
+
+int main() {
+    std::cout << "Engine Test Suite" << std::endl;
+    std::cout << "=================" << std::endl;
+    std::cout << std::endl;
+
+    std::vector<std::pair<std::string, TestResult>> results;
+    results.emplace_back("Plan Validation", test_plan_validation());
+    results.emplace_back("Plan Reuse", test_plan_reuse());
+    results.emplace_back("Plan Matches Reference", test_plan_matches_reference());
+    results.emplace_back("Context Matches Plan", test_context_matches_plan());
+    results.emplace_back("Concurrent Contexts", test_concurrent_contexts());
+    results.emplace_back("Range Sharding", test_range_sharding());
+    results.emplace_back("Large Path Offsets", test_large_path_offsets());
+    results.emplace_back("Checkpoint Resume", test_checkpoint_resume());
+    results.emplace_back("Checkpoint Mismatch", test_checkpoint_mismatch());
+    results.emplace_back("Chunked Matches Run", test_chunked_matches_run());
+    results.emplace_back("Progress Records", test_progress_records());
+    results.emplace_back("Cancellation", test_cancellation());
+    results.emplace_back("Deadline", test_deadline());
+    results.emplace_back("Thread Count Independence", test_thread_count_independence());
+    results.emplace_back("Moment Matching", test_moment_matching());
+    results.emplace_back("Martingale Correction", test_martingale_correction());
+    results.emplace_back("Correction Batch Count", test_correction_batch_count());
+
+    std::cout << std::endl;
+    int passed_tests = 0;
+    for (const auto& entry : results) {
+        print_test_result(entry.first, entry.second);
+        passed_tests += entry.second.passed ? 1 : 0;
+    }
+
+    int total_tests = static_cast<int>(results.size());
+    std::cout << std::endl;
+    std::cout << "Passed: " << passed_tests << "/" << total_tests << std::endl;
+    return passed_tests == total_tests ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+#include <iostream>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "../include/greeks.hpp"
+#include "../include/black_scholes.hpp"
+#include "test_util.hpp"
+
+/**
+ * @brief Tests for bump-and-revalue Greeks
+ *
+ * This test suite verifies:
+ * 1. Greeks of calls and puts match the closed-form Black-Scholes Greeks
+ * 2. Common random numbers make the Greek errors far smaller than
+ *    differences of independent prices
+ * 3. Ladder points match Black-Scholes at their shifted inputs
+ * 4. Greeks are bit-identical on any thread count, with or without a drift shift
+ * 5. Bumps that leave the model's domain are rejected
+ */
+
+const GBMParams params = {100.0, 0.2, 1.0, 12};
+const double K = 100.0;
+const double r = 0.05;
+
+// Monte Carlo estimate within 4 standard errors plus the finite-difference
+// bias allowance of the reference
+bool close(const MCResult& estimate, double reference, double allowance) {
+    return std::abs(estimate.price - reference) < 4.0 * estimate.stderr + allowance;
+}
+
+bool matches_black_scholes(const GreeksPoint& point, bool call) {
+    double price = call ? bs_call(point.S0, K, r, point.sigma, point.T) : bs_put(point.S0, K, r, point.sigma, point.T);
+    BSGreeks greeks = bs_greeks(point.S0, K, r, point.sigma, point.T, call);
+    return close(point.price, price, 0.0) &&
+           close(point.delta, greeks.delta, 1e-3) &&
+           close(point.gamma, greeks.gamma, 1e-2 * greeks.gamma) &&
+           close(point.vega, greeks.vega, 1e-2 * greeks.vega) &&
+           close(point.theta, greeks.theta, 1e-2 * std::abs(greeks.theta));
+}
+
+TestResult test_black_scholes_greeks() {
+    std::cout << "Testing Greeks against Black-Scholes..." << std::endl;
+
+    PricingContext context(2, 1);
+    bool passed = true;
+    for (bool call : {true, false}) {
+        PricingPlan plan(params, r, PayoffSpec{K, call}, EngineOptions{200000, 5});
+        GreeksReport report = bump_and_revalue(context, plan, GreeksOptions());
+        const GreeksPoint& base = report.base;
+        BSGreeks greeks = bs_greeks(params.S0, K, r, params.sigma, params.T, call);
+        std::cout << "  " << (call ? "call" : "put ") << ": delta " << base.delta.price << " +/- "
+                  << base.delta.stderr << " (BS " << greeks.delta << "), gamma " << base.gamma.price
+                  << " +/- " << base.gamma.stderr << " (BS " << greeks.gamma << ")" << std::endl;
+        std::cout << "        vega " << base.vega.price << " +/- " << base.vega.stderr << " (BS "
+                  << greeks.vega << "), theta " << base.theta.price << " +/- " << base.theta.stderr
+                  << " (BS " << greeks.theta << ")" << std::endl;
+        passed = passed && matches_black_scholes(base, call);
+    }
+    return make_result(passed);
+}
+
+TestResult test_common_random_numbers() {
+    std::cout << "Testing common random numbers..." << std::endl;
+
+    PricingContext context(2, 1);
+    PricingPlan plan(params, r, PayoffSpec{K, true}, EngineOptions{100000, 6});
+    GreeksOptions options;
+    GreeksReport report = bump_and_revalue(context, plan, options);
+
+    // Independent up and down prices would each carry the price error
+    const double hS = options.spot_bump * params.S0;
+    double independent_delta = std::sqrt(2.0) * report.base.price.stderr / (2.0 * hS);
+    double independent_vega = std::sqrt(2.0) * report.base.price.stderr / (2.0 * options.vol_bump);
+    std::cout << "  delta stderr " << report.base.delta.stderr << " (independent ~" << independent_delta
+              << "), vega stderr " << report.base.vega.stderr << " (independent ~" << independent_vega
+              << ")" << std::endl;
+
+    bool passed = report.base.delta.stderr < 0.1 * independent_delta &&
+                  report.base.vega.stderr < 0.1 * independent_vega;
+    return make_result(passed);
+}
+
+TestResult test_ladders() {
+    std::cout << "Testing ladders..." << std::endl;
+
+    PricingContext context(2, 1);
+    PricingPlan plan(params, r, PayoffSpec{K, false}, EngineOptions{100000, 7});
+    GreeksOptions options;
+    options.spot_ladder = {-0.1, -0.05, 0.05, 0.1};
+    options.vol_ladder = {-0.05, 0.05};
+    options.maturity_ladder = {-0.5, 1.0};
+    GreeksReport report = bump_and_revalue(context, plan, options);
+
+    bool passed = report.spot_ladder.size() == 4 && report.vol_ladder.size() == 2 &&
+                  report.maturity_ladder.size() == 2 &&
+                  report.spot_ladder[0].S0 == 90.0 && report.vol_ladder[1].sigma == 0.25 &&
+                  report.maturity_ladder[0].T == 0.5;
+    for (const auto* ladder : {&report.spot_ladder, &report.vol_ladder, &report.maturity_ladder}) {
+        for (const GreeksPoint& point : *ladder) {
+            passed = passed && matches_black_scholes(point, false);
+        }
+    }
+    return make_result(passed);
+}
+
+TestResult test_thread_count_independence() {
+    std::cout << "Testing thread-count independence..." << std::endl;
+
+    GreeksOptions options;
+    options.spot_ladder = {0.05};
+    bool passed = true;
+    for (double shift : {0.0, 0.8}) {
+        PricingPlan plan(params, r, PayoffSpec{120.0, true}, EngineOptions{10001, 8, shift});
+        PricingContext single(1, 1);
+        PricingContext multi(3, 1);
+        GreeksReport a = bump_and_revalue(single, plan, options);
+        GreeksReport b = bump_and_revalue(multi, plan, options);
+        passed = passed && a.base.price.price == b.base.price.price &&
+                 a.base.delta.price == b.base.delta.price && a.base.gamma.stderr == b.base.gamma.stderr &&
+                 a.spot_ladder[0].theta.price == b.spot_ladder[0].theta.price;
+    }
+    return make_result(passed);
+}
+
+TestResult test_invalid_bumps() {
+    std::cout << "Testing bump validation..." << std::endl;
+
+    PricingContext context(1, 1);
+    PricingPlan plan(params, r, PayoffSpec{K, true}, EngineOptions{1000, 1});
+
+    auto rejected = [&](const GreeksOptions& options, const PricingPlan& target) {
+        try {
+            bump_and_revalue(context, target, options);
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+
+    GreeksOptions zero_bump;
+    zero_bump.vol_bump = 0.0;
+    GreeksOptions past_expiry;
+    past_expiry.maturity_ladder = {-1.0};
+    GreeksOptions negative_vol;
+    negative_vol.vol_ladder = {-0.195};
+    GreeksOptions negative_spot;
+    negative_spot.spot_ladder = {-1.0};
+
+    EngineOptions corrected{2 * kCorrectionBatchPaths, 1};
+    corrected.moment_matching = true;
+    PricingPlan corrected_plan(params, r, PayoffSpec{K, true}, corrected);
+
+    bool passed = rejected(zero_bump, plan) && rejected(past_expiry, plan) && rejected(negative_vol, plan) &&
+                  rejected(negative_spot, plan) && rejected(GreeksOptions(), corrected_plan) &&
+                  !rejected(GreeksOptions(), plan);
+    return make_result(passed);
+}
+
+int main() {
+    std::cout << "Greeks Test Suite" << std::endl;
+    std::cout << "=================" << std::endl;
+    std::cout << std::endl;
+
+    TestResult black_scholes_test = test_black_scholes_greeks();
+    TestResult crn_test = test_common_random_numbers();
+    TestResult ladder_test = test_ladders();
+    TestResult threads_test = test_thread_count_independence();
+    TestResult invalid_test = test_invalid_bumps();
+
+    std::cout << std::endl;
+    print_test_result("Black-Scholes Greeks", black_scholes_test);
+    print_test_result("Common Random Numbers", crn_test);
+    print_test_result("Ladders", ladder_test);
+    print_test_result("Thread Count Independence", threads_test);
+    print_test_result("Invalid Bumps", invalid_test);
+
+    int total_tests = 5;
+    int passed_tests = (black_scholes_test.passed ? 1 : 0) +
+                       (crn_test.passed ? 1 : 0) +
+                       (ladder_test.passed ? 1 : 0) +
+                       (threads_test.passed ? 1 : 0) +
+                       (invalid_test.passed ? 1 : 0);
+
+    std::cout << std::endl;
+    std::cout << "Passed: " << passed_tests << "/" << total_tests << std::endl;
+    return passed_tests == total_tests ? 0 : 1;
+}
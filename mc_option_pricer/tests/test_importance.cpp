@@ -0,0 +1,162 @@
+#include <iostream>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include "../include/importance_sampling.hpp"
+#include "../include/black_scholes.hpp"
+#include "test_util.hpp"
+
+/**
+ * @brief Tests for importance sampling
+ *
+ * This test suite verifies:
+ * 1. The optimal shift maximizes log payoff(z) - z^2/2
+ * 2. Shifted estimates stay unbiased at the money
+ * 3. Deep out-of-the-money calls and puts converge with large variance reductions
+ * 4. Non-finite shifts are rejected
+ * 5. Degenerate errors report an infinite or undefined variance reduction
+ */
+
+const GBMParams params = {100.0, 0.2, 1.0, 12};
+const double r = 0.05;
+
+// log payoff(z) - z^2 / 2 for the terminal normal z
+double log_density(const PayoffSpec& payoff, double z) {
+    double S = params.S0 * std::exp((r - 0.5 * params.sigma * params.sigma) * params.T +
+                                    params.sigma * std::sqrt(params.T) * z);
+    double value = payoff.call ? S - payoff.K : payoff.K - S;
+    return value > 0.0 ? std::log(value) - 0.5 * z * z : -std::numeric_limits<double>::infinity();
+}
+
+TestResult test_optimal_shift() {
+    std::cout << "Testing the saddle-point shift..." << std::endl;
+
+    bool passed = true;
+    for (PayoffSpec payoff : {PayoffSpec{150.0, true}, PayoffSpec{100.0, true}, PayoffSpec{60.0, false}}) {
+        double a = optimal_drift_shift(params, r, payoff);
+        passed = passed && log_density(payoff, a) > log_density(payoff, a + 1e-3) &&
+                 log_density(payoff, a) > log_density(payoff, a - 1e-3);
+        std::cout << "  K = " << payoff.K << (payoff.call ? " call" : " put") << ": shift " << a << std::endl;
+    }
+
+    GBMParams flat = params;
+    flat.sigma = 0.0;
+    passed = passed && optimal_drift_shift(params, r, PayoffSpec{150.0, true}) > 0.0 &&
+             optimal_drift_shift(params, r, PayoffSpec{60.0, false}) < 0.0 &&
+             optimal_drift_shift(flat, r, PayoffSpec{150.0, true}) == 0.0;
+    return make_result(passed);
+}
+
+TestResult test_unbiased_at_the_money() {
+    std::cout << "Testing shifted estimates at the money..." << std::endl;
+
+    PricingContext context(2, 1);
+    PayoffSpec payoff{100.0, true};
+    double bs_price = bs_call(params.S0, payoff.K, r, params.sigma, params.T);
+
+    // Any finite shift is unbiased; the optimal one also lowers the variance
+    bool passed = true;
+    for (double shift : {-0.5, 0.5, optimal_drift_shift(params, r, payoff)}) {
+        PricingPlan plan(params, r, payoff, EngineOptions{200000, 4, shift});
+        MCResult result = context.run(plan);
+        passed = passed && std::abs(result.price - bs_price) < 4.0 * result.stderr;
+    }
+
+    // A zero shift is plain Monte Carlo, bit for bit
+    MCResult plain = context.run(PricingPlan(params, r, payoff, EngineOptions{10000, 4}));
+    MCResult zero = context.run(PricingPlan(params, r, payoff, EngineOptions{10000, 4, 0.0}));
+    passed = passed && plain.price == zero.price && plain.stderr == zero.stderr;
+    return make_result(passed);
+}
+
+TestResult test_deep_out_of_the_money() {
+    std::cout << "Testing deep out-of-the-money options..." << std::endl;
+
+    PricingContext context(2, 1);
+    const std::int64_t n_paths = 50000;
+
+    ImportanceSamplingReport call = importance_sampling_report(context, params, r,
+                                                               PayoffSpec{200.0, true}, n_paths, 7);
+    ImportanceSamplingReport put = importance_sampling_report(context, params, r,
+                                                              PayoffSpec{50.0, false}, n_paths, 8);
+    double bs_call_price = bs_call(params.S0, 200.0, r, params.sigma, params.T);
+    double bs_put_price = bs_put(params.S0, 50.0, r, params.sigma, params.T);
+
+    std::cout << "  call: " << call.shifted.price << " +/- " << call.shifted.stderr
+              << " (BS " << bs_call_price << ", variance reduction " << call.variance_reduction << ")"
+              << std::endl;
+    std::cout << "  put:  " << put.shifted.price << " +/- " << put.shifted.stderr
+              << " (BS " << bs_put_price << ", variance reduction " << put.variance_reduction << ")"
+              << std::endl;
+
+    bool passed = std::abs(call.shifted.price - bs_call_price) < 4.0 * call.shifted.stderr &&
+                  std::abs(put.shifted.price - bs_put_price) < 4.0 * put.shifted.stderr &&
+                  call.shifted.stderr < 0.02 * bs_call_price &&
+                  put.shifted.stderr < 0.02 * bs_put_price &&
+                  call.variance_reduction > 100.0 && put.variance_reduction > 100.0;
+    return make_result(passed);
+}
+
+TestResult test_invalid_shift() {
+    std::cout << "Testing shift validation..." << std::endl;
+
+    bool passed = false;
+    try {
+        PricingPlan plan(params, r, PayoffSpec{100.0, true},
+                         EngineOptions{1000, 1, std::numeric_limits<double>::infinity()});
+    } catch (const std::invalid_argument&) {
+        passed = true;
+    }
+    return make_result(passed);
+}
+
+TestResult test_degenerate_reduction() {
+    std::cout << "Testing degenerate variance reductions..." << std::endl;
+
+    PricingContext context(2, 1);
+    // No plain path reaches a strike ten standard deviations out
+    ImportanceSamplingReport unreachable = importance_sampling_report(context, params, r,
+                                                                      PayoffSpec{700.0, true}, 1000, 3);
+    // Without volatility neither estimate has a sampling error
+    GBMParams flat = params;
+    flat.sigma = 0.0;
+    ImportanceSamplingReport riskless = importance_sampling_report(context, flat, r,
+                                                                   PayoffSpec{90.0, true}, 1000, 3);
+    std::cout << "  unreachable strike: " << unreachable.variance_reduction
+              << ", zero volatility: " << riskless.variance_reduction << std::endl;
+
+    bool passed = unreachable.plain.stderr == 0.0 && unreachable.shifted.stderr > 0.0 &&
+                  std::isinf(unreachable.variance_reduction) && std::isnan(riskless.variance_reduction);
+    return make_result(passed);
+}
+
+int main() {
+    std::cout << "Importance Sampling Test Suite" << std::endl;
+    std::cout << "==============================" << std::endl;
+    std::cout << std::endl;
+
+    TestResult shift_test = test_optimal_shift();
+    TestResult atm_test = test_unbiased_at_the_money();
+    TestResult otm_test = test_deep_out_of_the_money();
+    TestResult invalid_test = test_invalid_shift();
+    TestResult degenerate_test = test_degenerate_reduction();
+
+    std::cout << std::endl;
+    print_test_result("Optimal Shift", shift_test);
+    print_test_result("Unbiased At The Money", atm_test);
+    print_test_result("Deep Out Of The Money", otm_test);
+    print_test_result("Invalid Shift", invalid_test);
+    print_test_result("Degenerate Reduction", degenerate_test);
+
+    int total_tests = 5;
+    int passed_tests = (shift_test.passed ? 1 : 0) +
+                       (atm_test.passed ? 1 : 0) +
+                       (otm_test.passed ? 1 : 0) +
+                       (invalid_test.passed ? 1 : 0) +
+                       (degenerate_test.passed ? 1 : 0);
+
+    std::cout << std::endl;
+    std::cout << "Passed: " << passed_tests << "/" << total_tests << std::endl;
+    return passed_tests == total_tests ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+#include <iostream>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "../include/local_vol.hpp"
+#include "../include/black_scholes.hpp"
+#include "test_util.hpp"
+
+/**
+ * @brief Tests for Dupire local volatility
+ *
+ * This test suite verifies:
+ * 1. Bilinear surface interpolation, flat outside the grid
+ * 2. Dupire recovers a flat volatility from a flat implied surface
+ * 3. A flat local volatility reproduces the PricingPlan of the same inputs
+ * 4. Local-volatility prices reprice a skewed implied surface
+ * 5. Prices are bit-identical on any thread count
+ * 6. Invalid surfaces and inputs are rejected
+ */
+
+const double S0 = 100.0;
+const double r = 0.03;
+
+// Skew steepening at short maturities, rising slowly with maturity
+double skewed_vol(double K, double T) {
+    return 0.2 - 0.05 * std::log(K / (S0 * std::exp(r * T))) / std::sqrt(T) + 0.02 * T;
+}
+
+ImpliedVolSurface implied_surface(bool flat) {
+    ImpliedVolSurface implied;
+    implied.maturities = {0.25, 0.5, 1.0, 2.0};
+    for (double K = 40.0; K <= 250.0; K += 5.0) {
+        implied.strikes.push_back(K);
+    }
+    for (double T : implied.maturities) {
+        for (double K : implied.strikes) {
+            implied.vols.push_back(flat ? 0.25 : skewed_vol(K, T));
+        }
+    }
+    return implied;
+}
+
+std::vector<double> slice_times() {
+    std::vector<double> times;
+    for (int i = 0; i <= 40; ++i) {
+        times.push_back(0.05 * i);
+    }
+    return times;
+}
+
+TestResult test_interpolation() {
+    std::cout << "Testing surface interpolation..." << std::endl;
+
+    // Nodes at S = 50, 100, 200; slices at t = 0 and t = 1
+    LocalVolSurface surface({0.0, 1.0}, 50.0, 200.0, 3, {0.1, 0.2, 0.4, 0.3, 0.4, 0.6});
+    auto near = [](double a, double b) { return std::abs(a - b) < 1e-12; };
+
+    bool passed = near(surface.value(0.0, 100.0), 0.2) && near(surface.value(1.0, 200.0), 0.6) &&
+                  near(surface.value(0.5, 100.0), 0.3) &&
+                  near(surface.value(0.0, std::sqrt(50.0 * 100.0)), 0.15) &&
+                  near(surface.value(0.25, std::sqrt(100.0 * 200.0)), 0.75 * 0.3 + 0.25 * 0.5) &&
+                  near(surface.value(2.0, 1000.0), 0.6) && near(surface.value(-1.0, 1.0), 0.1);
+    return make_result(passed);
+}
+
+TestResult test_flat_dupire() {
+    std::cout << "Testing Dupire on a flat implied surface..." << std::endl;
+
+    LocalVolSurface surface = dupire_local_vol(implied_surface(true), S0, r, slice_times(), 20.0, 500.0, 101);
+    double worst = 0.0;
+    for (double t : {0.0, 0.3, 1.0, 2.0}) {
+        for (double S : {30.0, 80.0, 100.0, 130.0, 400.0}) {
+            worst = std::max(worst, std::abs(surface.value(t, S) - 0.25));
+        }
+    }
+    std::cout << "  largest deviation from 0.25: " << worst << std::endl;
+    return make_result(worst < 1e-6);
+}
+
+TestResult test_flat_local_vol() {
+    std::cout << "Testing a flat local volatility against PricingPlan..." << std::endl;
+
+    PricingContext context(2, 1);
+    LocalVolSurface surface({0.0}, 20.0, 500.0, 11, std::vector<double>(11, 0.2));
+    bool passed = true;
+    for (bool call : {true, false}) {
+        PayoffSpec payoff{105.0, call};
+        EngineOptions engine{20000, 3};
+        MCResult local = LocalVolPlan(LocalVolModel{S0, r, 1.0, 52}, surface, payoff, engine).run(context);
+        MCResult flat = context.run(PricingPlan(GBMParams{S0, 0.2, 1.0, 52}, r, payoff, engine));
+        // Same normals and the exact step of constant volatility
+        passed = passed && std::abs(local.price - flat.price) < 1e-9 && std::abs(local.stderr - flat.stderr) < 1e-9;
+    }
+    return make_result(passed);
+}
+
+TestResult test_skew_repricing() {
+    std::cout << "Testing repricing of a skewed implied surface..." << std::endl;
+
+    PricingContext context(2, 1);
+    LocalVolSurface surface = dupire_local_vol(implied_surface(false), S0, r, slice_times(), 20.0, 500.0, 201);
+
+    bool passed = true;
+    for (double T : {0.5, 1.0}) {
+        for (PayoffSpec payoff : {PayoffSpec{80.0, false}, PayoffSpec{100.0, true}, PayoffSpec{120.0, true}}) {
+            int steps = static_cast<int>(100 * T);
+            MCResult mc = LocalVolPlan(LocalVolModel{S0, r, T, steps}, surface, payoff, EngineOptions{100000, 6})
+                              .run(context);
+            double vol = skewed_vol(payoff.K, T);
+            double bs = payoff.call ? bs_call(S0, payoff.K, r, vol, T) : bs_put(S0, payoff.K, r, vol, T);
+            std::cout << "  T " << T << " K " << payoff.K << ": " << mc.price << " +/- " << mc.stderr
+                      << " (implied vol " << vol << " gives " << bs << ")" << std::endl;
+            passed = passed && std::abs(mc.price - bs) < 4.0 * mc.stderr;
+        }
+    }
+    return make_result(passed);
+}
+
+TestResult test_thread_count_independence() {
+    std::cout << "Testing thread-count independence..." << std::endl;
+
+    LocalVolSurface surface = dupire_local_vol(implied_surface(false), S0, r, slice_times(), 20.0, 500.0, 101);
+    LocalVolPlan plan(LocalVolModel{S0, r, 1.0, 24}, surface, PayoffSpec{100.0, true}, EngineOptions{10001, 5});
+    PricingContext single(1, 1);
+    PricingContext multi(3, 1);
+    MCResult a = plan.run(single);
+    MCResult b = plan.run(multi);
+    return make_result(a.price == b.price && a.stderr == b.stderr);
+}
+
+TestResult test_invalid_inputs() {
+    std::cout << "Testing input validation..." << std::endl;
+
+    auto rejected = [](auto build) {
+        try {
+            build();
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+
+    LocalVolSurface surface({0.0}, 50.0, 200.0, 2, {0.2, 0.2});
+    ImpliedVolSurface ragged = implied_surface(true);
+    ragged.vols.pop_back();
+    ImpliedVolSurface unsorted = implied_surface(true);
+    unsorted.maturities = {0.5, 0.25, 1.0, 2.0};
+    PayoffSpec payoff{100.0, true};
+    EngineOptions engine{1000, 1};
+
+    bool passed =
+        rejected([] { LocalVolSurface({0.0}, 50.0, 200.0, 1, {0.2}); }) &&
+        rejected([] { LocalVolSurface({0.0}, 200.0, 50.0, 2, {0.2, 0.2}); }) &&
+        rejected([] { LocalVolSurface({0.0, 0.0}, 50.0, 200.0, 2, {0.2, 0.2, 0.2, 0.2}); }) &&
+        rejected([] { LocalVolSurface({0.0}, 50.0, 200.0, 2, {0.2, -0.1}); }) &&
+        rejected([] { LocalVolSurface({0.0}, 50.0, 200.0, 2, {0.2}); }) &&
+        rejected([&] { dupire_local_vol(ragged, S0, r, slice_times(), 20.0, 500.0, 11); }) &&
+        rejected([&] { dupire_local_vol(unsorted, S0, r, slice_times(), 20.0, 500.0, 11); }) &&
+        rejected([&] { LocalVolPlan(LocalVolModel{S0, r, 0.0, 12}, surface, payoff, engine); }) &&
+        rejected([&] { LocalVolPlan(LocalVolModel{S0, r, 1.0, 12}, surface, payoff, EngineOptions{1000, 1, 0.5}); }) &&
+        !rejected([&] { LocalVolPlan(LocalVolModel{S0, r, 1.0, 12}, surface, payoff, engine); });
+    return make_result(passed);
+}
+
+int main() {
+    std::cout << "Local Volatility Test Suite" << std::endl;
+    std::cout << "===========================" << std::endl;
+    std::cout << std::endl;
+
+    TestResult interpolation_test = test_interpolation();
+    TestResult dupire_test = test_flat_dupire();
+    TestResult flat_test = test_flat_local_vol();
+    TestResult skew_test = test_skew_repricing();
+    TestResult threads_test = test_thread_count_independence();
+    TestResult invalid_test = test_invalid_inputs();
+
+    std::cout << std::endl;
+    print_test_result("Interpolation", interpolation_test);
+    print_test_result("Flat Dupire", dupire_test);
+    print_test_result("Flat Local Volatility", flat_test);
+    print_test_result("Skew Repricing", skew_test);
+    print_test_result("Thread Count Independence", threads_test);
+    print_test_result("Invalid Inputs", invalid_test);
+
+    int total_tests = 6;
+    int passed_tests = (interpolation_test.passed ? 1 : 0) +
+                       (dupire_test.passed ? 1 : 0) +
+                       (flat_test.passed ? 1 : 0) +
+                       (skew_test.passed ? 1 : 0) +
+                       (threads_test.passed ? 1 : 0) +
+                       (invalid_test.passed ? 1 : 0);
+
+    std::cout << std::endl;
+    std::cout << "Passed: " << passed_tests << "/" << total_tests << std::endl;
+    return passed_tests == total_tests ? 0 : 1;
+}
@@ -0,0 +1,52 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include "../include/pricing_context.hpp"
+#include "../include/black_scholes.hpp"
+
+/**
+ * @brief Long-running test of a single valuation above 2^31 paths
+ *
+ * Built only with -DMC_LONG_TESTS=ON. Prices one call with
+ * 2^31 + 2^20 single-step paths on all available threads (tens of minutes
+ * on one core) and checks the path count, the statistics and the price
+ * against Black-Scholes.
+ */
+
+int main() {
+    std::cout << "Long Run Test" << std::endl;
+    std::cout << "=============" << std::endl;
+    std::cout << std::endl;
+
+    const GBMParams params = {100.0, 0.2, 1.0, 1};
+    const double K = 100.0;
+    const double r = 0.05;
+    const std::int64_t n_paths = (1LL << 31) + (1LL << 20);
+
+    PricingContext context(0, 1);
+    PricingPlan plan(params, r, PayoffSpec{K, true}, EngineOptions{n_paths, 2024});
+
+    std::cout << "Pricing " << n_paths << " paths on " << context.threads() << " threads..." << std::endl;
+    auto start = std::chrono::steady_clock::now();
+    MCResult result = context.run(plan);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double bs_price = bs_call(params.S0, K, r, params.sigma, params.T);
+    double z = std::abs(result.price - bs_price) / result.stderr;
+
+    std::cout << "  Monte Carlo:   " << result.price << " +/- " << result.stderr << std::endl;
+    std::cout << "  Black-Scholes: " << bs_price << std::endl;
+    std::cout << "  z-score:       " << z << std::endl;
+    std::cout << "  Runtime:       " << seconds << " s" << std::endl;
+
+    // stderr ~ sigma_payoff / sqrt(n): about 3e-4 for this option
+    bool passed = context.stats().paths == static_cast<std::uint64_t>(n_paths) &&
+                  result.stderr > 0.0 && result.stderr < 1e-3 &&
+                  z < 5.0;
+
+    std::cout << std::endl;
+    std::cout << "=== Long Run === " << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
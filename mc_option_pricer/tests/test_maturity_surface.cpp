@@ -0,0 +1,134 @@
+#include <iostream>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../include/maturity_surface.hpp"
+#include "../include/black_scholes.hpp"
+#include "test_util.hpp"
+
+/**
+ * @brief Tests for strike x maturity surfaces
+ *
+ * This test suite verifies:
+ * 1. Every point of a surface, on and off the step grid, matches Black-Scholes
+ * 2. The horizon column equals a PricingPlan run at the horizon
+ * 3. Surfaces are bit-identical on any thread count
+ * 4. Invalid maturities, payoffs and engines are rejected
+ */
+
+const GBMParams params = {100.0, 0.2, 1.0, 52};
+const double r = 0.05;
+
+const std::vector<PayoffSpec> payoffs = {{90.0, true}, {100.0, true}, {110.0, true}, {95.0, false}, {105.0, false}};
+
+TestResult test_black_scholes_surface() {
+    std::cout << "Testing the surface against Black-Scholes..." << std::endl;
+
+    PricingContext context(2, 1);
+    // 0.37 and 0.9 fall between grid points and are inserted
+    std::vector<double> maturities = {1.0, 0.25, 0.37, 0.5, 0.9};
+    MaturitySurface surface = price_surface(context, params, r, maturities, payoffs, EngineOptions{100000, 3});
+
+    bool passed = surface.prices.size() == maturities.size() * payoffs.size();
+    int outside = 0;
+    for (std::size_t m = 0; m < maturities.size(); ++m) {
+        for (std::size_t j = 0; j < payoffs.size(); ++j) {
+            const PayoffSpec& payoff = payoffs[j];
+            double bs = payoff.call ? bs_call(params.S0, payoff.K, r, params.sigma, maturities[m])
+                                    : bs_put(params.S0, payoff.K, r, params.sigma, maturities[m]);
+            if (std::abs(surface.at(m, j).price - bs) >= 4.0 * surface.at(m, j).stderr) {
+                ++outside;
+            }
+        }
+    }
+    std::cout << "  " << outside << " of " << surface.prices.size()
+              << " points outside 4 standard errors" << std::endl;
+    return make_result(passed && outside == 0);
+}
+
+TestResult test_horizon_matches_plan() {
+    std::cout << "Testing the horizon against PricingPlan..." << std::endl;
+
+    PricingContext context(1, 1);
+    EngineOptions engine{20001, 4};
+    // 0.25 and 0.5 are grid points, so the horizon's path is unchanged
+    MaturitySurface surface = price_surface(context, params, r, {0.25, 0.5, 1.0}, payoffs, engine);
+
+    bool passed = true;
+    for (std::size_t j = 0; j < payoffs.size(); ++j) {
+        MCResult run = context.run(PricingPlan(params, r, payoffs[j], engine));
+        passed = passed && surface.at(2, j).price == run.price && surface.at(2, j).stderr == run.stderr;
+    }
+    return make_result(passed);
+}
+
+TestResult test_thread_count_independence() {
+    std::cout << "Testing thread-count independence..." << std::endl;
+
+    std::vector<double> maturities = {0.1, 0.75, 0.333};
+    EngineOptions engine{10001, 5};
+    PricingContext single(1, 1);
+    PricingContext multi(3, 1);
+    MaturitySurface a = price_surface(single, params, r, maturities, payoffs, engine);
+    MaturitySurface b = price_surface(multi, params, r, maturities, payoffs, engine);
+
+    bool passed = true;
+    for (std::size_t n = 0; n < a.prices.size(); ++n) {
+        passed = passed && a.prices[n].price == b.prices[n].price && a.prices[n].stderr == b.prices[n].stderr;
+    }
+    return make_result(passed);
+}
+
+TestResult test_invalid_inputs() {
+    std::cout << "Testing input validation..." << std::endl;
+
+    PricingContext context(1, 1);
+    auto rejected = [&](const std::vector<double>& maturities, const std::vector<PayoffSpec>& targets,
+                        const EngineOptions& engine) {
+        try {
+            price_surface(context, params, r, maturities, targets, engine);
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+
+    EngineOptions plain{1000, 1};
+    EngineOptions shifted{1000, 1, 0.5};
+    EngineOptions corrected{2 * kCorrectionBatchPaths, 1};
+    corrected.moment_matching = true;
+
+    bool passed = rejected({}, payoffs, plain) && rejected({0.5}, {}, plain) &&
+                  rejected({0.0}, payoffs, plain) && rejected({1.5}, payoffs, plain) &&
+                  rejected({0.5}, {{-1.0, true}}, plain) && rejected({0.5}, payoffs, shifted) &&
+                  rejected({0.5}, payoffs, corrected) && !rejected({0.5, 0.5}, payoffs, plain);
+    return make_result(passed);
+}
+
+int main() {
+    std::cout << "Maturity Surface Test Suite" << std::endl;
+    std::cout << "===========================" << std::endl;
+    std::cout << std::endl;
+
+    TestResult black_scholes_test = test_black_scholes_surface();
+    TestResult horizon_test = test_horizon_matches_plan();
+    TestResult threads_test = test_thread_count_independence();
+    TestResult invalid_test = test_invalid_inputs();
+
+    std::cout << std::endl;
+    print_test_result("Black-Scholes Surface", black_scholes_test);
+    print_test_result("Horizon Matches Plan", horizon_test);
+    print_test_result("Thread Count Independence", threads_test);
+    print_test_result("Invalid Inputs", invalid_test);
+
+    int total_tests = 4;
+    int passed_tests = (black_scholes_test.passed ? 1 : 0) +
+                       (horizon_test.passed ? 1 : 0) +
+                       (threads_test.passed ? 1 : 0) +
+                       (invalid_test.passed ? 1 : 0);
+
+    std::cout << std::endl;
+    std::cout << "Passed: " << passed_tests << "/" << total_tests << std::endl;
+    return passed_tests == total_tests ? 0 : 1;
+}
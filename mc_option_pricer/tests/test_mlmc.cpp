@@ -0,0 +1,145 @@
+#include <iostream>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "../include/mlmc.hpp"
+#include "../include/black_scholes.hpp"
+#include "test_util.hpp"
+
+/**
+ * @brief Tests for the multilevel Monte Carlo engine
+ *
+ * This test suite verifies:
+ * 1. European prices converge to Black-Scholes within the target RMSE
+ *    at a fraction of the single-level cost
+ * 2. Asian call and put satisfy put-call parity on the average
+ * 3. A seed gives bit-identical estimates on any thread count
+ * 4. Invalid options are rejected
+ */
+
+const GBMParams params = {100.0, 0.2, 1.0, 252};
+const double K = 100.0;
+const double r = 0.05;
+
+void print_levels(const MLMCResult& result) {
+    for (const MLMCLevel& level : result.levels) {
+        std::cout << "  steps " << level.steps << ": " << level.paths << " paths, V = "
+                  << level.variance << std::endl;
+    }
+    std::cout << "  cost " << result.cost << " steps vs " << result.single_level_cost
+              << " single-level" << std::endl;
+}
+
+TestResult test_european_convergence() {
+    std::cout << "Testing European convergence..." << std::endl;
+
+    const double eps = 0.02;
+    PricingContext context(2, 1);
+    MLMCResult result = mlmc_price(context, params, r, PayoffSpec{K, true}, MLMCProduct::European,
+                                   MLMCOptions{eps, 11});
+    print_levels(result);
+
+    double bs_price = bs_call(params.S0, K, r, params.sigma, params.T);
+
+    // Corrections shrink with refinement: Euler converges strongly
+    bool decaying = true;
+    for (std::size_t l = 2; l < result.levels.size(); ++l) {
+        decaying = decaying && result.levels[l].variance < result.levels[l - 1].variance;
+    }
+
+    bool passed = result.converged && result.levels.size() >= 3 && decaying &&
+                  std::abs(result.price - bs_price) < 3.0 * eps &&
+                  result.stderr < eps && result.bias < eps &&
+                  result.cost < 0.5 * result.single_level_cost;
+    return make_result(passed);
+}
+
+TestResult test_asian_parity() {
+    std::cout << "Testing Asian put-call parity..." << std::endl;
+
+    // C - P = exp(-rT) (E[A] - K), with E[A] = S0 (exp(rT) - 1) / (rT) for
+    // the continuous average the levels converge to
+    const double eps = 0.02;
+    PricingContext context(2, 1);
+    MLMCResult call = mlmc_price(context, params, r, PayoffSpec{K, true}, MLMCProduct::Asian,
+                                 MLMCOptions{eps, 5});
+    MLMCResult put = mlmc_price(context, params, r, PayoffSpec{K, false}, MLMCProduct::Asian,
+                                MLMCOptions{eps, 6});
+
+    double average = params.S0 * (std::exp(r * params.T) - 1.0) / (r * params.T);
+    double parity = std::exp(-r * params.T) * (average - K);
+
+    bool passed = call.converged && put.converged &&
+                  std::abs((call.price - put.price) - parity) < 3.0 * std::sqrt(2.0) * eps &&
+                  call.price < bs_call(params.S0, K, r, params.sigma, params.T);
+    return make_result(passed);
+}
+
+TestResult test_thread_count_independence() {
+    std::cout << "Testing thread-count independence..." << std::endl;
+
+    PricingContext single(1, 1);
+    PricingContext multi(3, 1);
+    MLMCOptions options{0.05, 3};
+    MLMCResult a = mlmc_price(single, params, r, PayoffSpec{K, false}, MLMCProduct::European, options);
+    MLMCResult b = mlmc_price(multi, params, r, PayoffSpec{K, false}, MLMCProduct::European, options);
+
+    bool passed = a.price == b.price && a.stderr == b.stderr && a.levels.size() == b.levels.size();
+    for (std::size_t l = 0; passed && l < a.levels.size(); ++l) {
+        passed = a.levels[l].paths == b.levels[l].paths;
+    }
+    return make_result(passed);
+}
+
+TestResult test_invalid_options() {
+    std::cout << "Testing option validation..." << std::endl;
+
+    auto rejected = [](const GBMParams& p, const MLMCOptions& options) {
+        try {
+            PricingContext context(1, 1);
+            mlmc_price(context, p, r, PayoffSpec{K, true}, MLMCProduct::European, options);
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+
+    MLMCOptions zero_rmse{0.0, 1};
+    MLMCOptions no_refinement{0.1, 1};
+    no_refinement.refinement = 1;
+    MLMCOptions too_fine{0.1, 1};
+    too_fine.max_levels = 40;
+    GBMParams bad_spot = params;
+    bad_spot.S0 = -1.0;
+
+    bool passed = rejected(params, zero_rmse) && rejected(params, no_refinement) &&
+                  rejected(params, too_fine) && rejected(bad_spot, MLMCOptions{0.1, 1});
+    return make_result(passed);
+}
+
+int main() {
+    std::cout << "Multilevel Monte Carlo Test Suite" << std::endl;
+    std::cout << "=================================" << std::endl;
+    std::cout << std::endl;
+
+    TestResult european_test = test_european_convergence();
+    TestResult asian_test = test_asian_parity();
+    TestResult threads_test = test_thread_count_independence();
+    TestResult invalid_test = test_invalid_options();
+
+    std::cout << std::endl;
+    print_test_result("European Convergence", european_test);
+    print_test_result("Asian Parity", asian_test);
+    print_test_result("Thread Count Independence", threads_test);
+    print_test_result("Invalid Options", invalid_test);
+
+    int total_tests = 4;
+    int passed_tests = (european_test.passed ? 1 : 0) +
+                       (asian_test.passed ? 1 : 0) +
+                       (threads_test.passed ? 1 : 0) +
+                       (invalid_test.passed ? 1 : 0);
+
+    std::cout << std::endl;
+    std::cout << "Passed: " << passed_tests << "/" << total_tests << std::endl;
+    return passed_tests == total_tests ? 0 : 1;
+}
@@ -0,0 +1,202 @@
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include "../include/path_store.hpp"
+#include "../include/pricer.hpp"
+#include "test_util.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * @brief Tests for the memory-mapped path store
+ *
+ * This test suite verifies:
+ * 1. The header records the model, rate, seed and generator
+ * 2. Float64 stores reproduce the seeded pricer's paths exactly
+ * 3. Float32 stores price within a small tolerance of Float64
+ * 4. Several payoffs can be priced from one store
+ * 5. Rewriting a store leaves readers of the old file undisturbed
+ * 6. Store prices do not depend on the thread count and stay finite at
+ *    zero volatility
+ */
+
+const GBMParams params = {100.0, 0.2, 1.0, 16};
+const double r = 0.05;
+const int n_paths = 10000;       // Not a multiple of the chunk size
+const std::int64_t chunk = 1024;
+const std::uint64_t seed = 2024;
+
+std::string store_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+TestResult test_header() {
+    std::cout << "Testing path store header..." << std::endl;
+
+    std::string file = store_path("mc_paths_header.bin");
+    write_path_store(file, params, r, n_paths, seed, PathPrecision::Float64, chunk);
+    PathStoreReader store(file);
+    const PathStoreHeader& header = store.header();
+
+    bool passed = header.S0 == params.S0 && header.sigma == params.sigma &&
+                  header.T == params.T && header.steps == 16 && header.r == r &&
+                  header.seed == seed && header.chunk_paths == 1024 &&
+                  header.generator == static_cast<std::uint32_t>(PathGenerator::Xoshiro256StarStarPolar) &&
+                  store.n_paths() == n_paths && store.n_chunks() == 10 &&
+                  store.chunk_size(9) == n_paths - 9 * chunk &&
+                  store.row<double>(3, 0)[5] == params.S0;
+    std::remove(file.c_str());
+    return make_result(passed);
+}
+
+TestResult test_float64_matches_pricer() {
+    std::cout << "Testing Float64 store against seeded pricer..." << std::endl;
+
+    std::string file = store_path("mc_paths_f64.bin");
+    write_path_store(file, params, r, n_paths, seed, PathPrecision::Float64, chunk);
+    PathStoreReader store(file);
+
+    MCResult stored = price_from_store(store, 100.0, true);
+    MCResult direct = monte_carlo_price(params, 100.0, true, n_paths, r, seed);
+
+    bool passed = std::abs(stored.price - direct.price) < 1e-10 &&
+                  std::abs(stored.stderr - direct.stderr) < 1e-10;
+    std::remove(file.c_str());
+    return make_result(passed);
+}
+
+TestResult test_float32_store() {
+    std::cout << "Testing Float32 store..." << std::endl;
+
+    std::string file32 = store_path("mc_paths_f32.bin");
+    std::string file64 = store_path("mc_paths_f64b.bin");
+    write_path_store(file32, params, r, n_paths, seed, PathPrecision::Float32, chunk);
+    write_path_store(file64, params, r, n_paths, seed, PathPrecision::Float64, chunk);
+    PathStoreReader store32(file32);
+    PathStoreReader store64(file64);
+
+    MCResult price32 = price_from_store(store32, 105.0, false);
+    MCResult price64 = price_from_store(store64, 105.0, false);
+
+    bool passed = store32.precision() == PathPrecision::Float32 &&
+                  std::abs(price32.price - price64.price) < 1e-4;
+    std::remove(file32.c_str());
+    std::remove(file64.c_str());
+    return make_result(passed);
+}
+
+TestResult test_many_payoffs() {
+    std::cout << "Testing multiple payoffs from one store..." << std::endl;
+
+    std::string file = store_path("mc_paths_many.bin");
+    write_path_store(file, params, r, n_paths, seed, PathPrecision::Float64, chunk);
+    PathStoreReader store(file);
+
+    // Put-call parity holds sample by sample: C - P = S0 - K e^{-rT} up to MC noise
+    bool passed = true;
+    for (double K : {80.0, 100.0, 120.0}) {
+        MCResult call = price_from_store(store, K, true);
+        MCResult put = price_from_store(store, K, false);
+        double parity = params.S0 - K * std::exp(-r * params.T);
+        passed = passed && std::abs(call.price - put.price - parity) < 4.0 * (call.stderr + put.stderr);
+    }
+    std::remove(file.c_str());
+    return make_result(passed);
+}
+
+TestResult test_rewrite_while_mapped() {
+    std::cout << "Testing rewrite of a mapped store..." << std::endl;
+
+    std::string file = store_path("mc_paths_rewrite.bin");
+    write_path_store(file, params, r, n_paths, seed, PathPrecision::Float64, chunk);
+    PathStoreReader old_store(file);
+    MCResult before = price_from_store(old_store, 100.0, true);
+
+    // The new store replaces the file while old_store still maps it
+    write_path_store(file, params, r, 2 * n_paths, seed + 1, PathPrecision::Float64, chunk);
+    MCResult after = price_from_store(old_store, 100.0, true);
+    PathStoreReader new_store(file);
+
+    bool leftovers = false;
+    for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::temp_directory_path())) {
+        leftovers = leftovers || entry.path().filename().string().rfind("mc_paths_rewrite.bin.", 0) == 0;
+    }
+
+    bool passed = after.price == before.price && after.stderr == before.stderr &&
+                  old_store.header().seed == seed && new_store.header().seed == seed + 1 &&
+                  new_store.n_paths() == 2 * n_paths && !leftovers;
+    std::remove(file.c_str());
+    return make_result(passed);
+}
+
+TestResult test_store_reduction() {
+    std::cout << "Testing store reduction..." << std::endl;
+
+    std::string file = store_path("mc_paths_reduction.bin");
+    // 1000-path chunks: reduction leaves straddle chunk boundaries
+    write_path_store(file, params, r, n_paths, seed, PathPrecision::Float64, 1000);
+    PathStoreReader store(file);
+
+    bool passed = true;
+#ifdef _OPENMP
+    const int previous = omp_get_max_threads();
+    omp_set_num_threads(1);
+    MCResult serial = price_from_store(store, 100.0, true);
+    omp_set_num_threads(3);
+    MCResult parallel = price_from_store(store, 100.0, true);
+    omp_set_num_threads(previous);
+    passed = serial.price == parallel.price && serial.stderr == parallel.stderr;
+#endif
+
+    // Every path ends on the forward: the variance is zero up to rounding,
+    // which must not turn into a NaN error
+    std::string flat_file = store_path("mc_paths_flat.bin");
+    GBMParams flat = params;
+    flat.sigma = 0.0;
+    write_path_store(flat_file, flat, r, n_paths, seed, PathPrecision::Float64, chunk);
+    PathStoreReader flat_store(flat_file);
+    MCResult flat_price = price_from_store(flat_store, 90.0, true);
+
+    passed = passed && std::isfinite(flat_price.stderr) && flat_price.stderr < 1e-6 &&
+             std::abs(flat_price.price - (params.S0 - 90.0 * std::exp(-r * params.T))) < 1e-9;
+    std::remove(file.c_str());
+    std::remove(flat_file.c_str());
+    return make_result(passed);
+}
+
+int main() {
+    std::cout << "Path Store Test Suite" << std::endl;
+    std::cout << "=====================" << std::endl;
+    std::cout << std::endl;
+
+    TestResult header_test = test_header();
+    TestResult f64_test = test_float64_matches_pricer();
+    TestResult f32_test = test_float32_store();
+    TestResult payoffs_test = test_many_payoffs();
+    TestResult rewrite_test = test_rewrite_while_mapped();
+    TestResult reduction_test = test_store_reduction();
+
+    std::cout << std::endl;
+    print_test_result("Header", header_test);
+    print_test_result("Float64 Matches Pricer", f64_test);
+    print_test_result("Float32 Store", f32_test);
+    print_test_result("Multiple Payoffs", payoffs_test);
+    print_test_result("Rewrite While Mapped", rewrite_test);
+    print_test_result("Store Reduction", reduction_test);
+
+    int total_tests = 6;
+    int passed_tests = (header_test.passed ? 1 : 0) +
+                       (f64_test.passed ? 1 : 0) +
+                       (f32_test.passed ? 1 : 0) +
+                       (payoffs_test.passed ? 1 : 0) +
+                       (rewrite_test.passed ? 1 : 0) +
+                       (reduction_test.passed ? 1 : 0);
+
+    std::cout << std::endl;
+    std::cout << "Passed: " << passed_tests << "/" << total_tests << std::endl;
+    return passed_tests == total_tests ? 0 : 1;
+}
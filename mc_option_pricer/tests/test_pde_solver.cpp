@@ -0,0 +1,173 @@
+#include <iostream>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "../include/pde_solver.hpp"
+#include "../include/black_scholes.hpp"
+#include "test_util.hpp"
+
+/**
+ * @brief Tests for the Crank-Nicolson PDE solver
+ *
+ * This test suite verifies:
+ * 1. Calls and puts match Black-Scholes prices, deltas and gammas
+ * 2. The error falls at second order as the grid is refined
+ * 3. A down-and-out call matches its closed form
+ * 4. Batched strikes give bit-identical results to single solves
+ * 5. Invalid inputs are rejected
+ */
+
+const double S0 = 100.0;
+const double r = 0.05;
+const double sigma = 0.2;
+const double T = 1.0;
+
+double normal_cdf(double x) {
+    return 0.5 * std::erfc(-x / std::sqrt(2.0));
+}
+
+TestResult test_black_scholes() {
+    std::cout << "Testing calls and puts against Black-Scholes..." << std::endl;
+
+    bool passed = true;
+    for (double K : {70.0, 90.0, 100.0, 115.0, 140.0}) {
+        for (bool call : {true, false}) {
+            PDEResult pde = pde_price(S0, r, sigma, T, PayoffSpec{K, call});
+            double bs = call ? bs_call(S0, K, r, sigma, T) : bs_put(S0, K, r, sigma, T);
+            double d1 = (std::log(S0 / K) + (r + 0.5 * sigma * sigma) * T) / (sigma * std::sqrt(T));
+            double delta = call ? normal_cdf(d1) : normal_cdf(d1) - 1.0;
+            double gamma = std::exp(-0.5 * d1 * d1) / std::sqrt(2.0 * M_PI) / (S0 * sigma * std::sqrt(T));
+            std::cout << "  K " << K << (call ? " call " : " put ") << pde.price << " vs " << bs << std::endl;
+            passed = passed && std::abs(pde.price - bs) < 1e-3 && std::abs(pde.delta - delta) < 1e-4 &&
+                     std::abs(pde.gamma - gamma) < 1e-5;
+        }
+    }
+    return make_result(passed);
+}
+
+TestResult test_convergence() {
+    std::cout << "Testing second-order convergence..." << std::endl;
+
+    double bs = bs_call(S0, 100.0, r, sigma, T);
+    double previous = 0.0;
+    bool passed = true;
+    for (int nodes : {50, 100, 200}) {
+        PDEOptions options;
+        options.space_nodes = nodes;
+        options.time_steps = nodes / 2;
+        double error = std::abs(pde_price(S0, r, sigma, T, PayoffSpec{100.0, true}, options).price - bs);
+        std::cout << "  " << nodes << " nodes: error " << error << std::endl;
+        // Halving both steps should cut the error about fourfold
+        passed = passed && (previous == 0.0 || previous / error > 3.0);
+        previous = error;
+    }
+    return make_result(passed);
+}
+
+TestResult test_down_and_out() {
+    std::cout << "Testing a down-and-out call against its closed form..." << std::endl;
+
+    bool passed = true;
+    for (double H : {80.0, 95.0}) {
+        double K = 100.0;
+        double lambda = (r + 0.5 * sigma * sigma) / (sigma * sigma);
+        double y = std::log(H * H / (S0 * K)) / (sigma * std::sqrt(T)) + lambda * sigma * std::sqrt(T);
+        double knock_in = S0 * std::pow(H / S0, 2.0 * lambda) * normal_cdf(y) -
+                          K * std::exp(-r * T) * std::pow(H / S0, 2.0 * lambda - 2.0) *
+                              normal_cdf(y - sigma * std::sqrt(T));
+        double exact = bs_call(S0, K, r, sigma, T) - knock_in;
+        PDEResult pde = pde_price(S0, r, sigma, T, PayoffSpec{K, true}, PDEOptions(), BarrierSpec{H});
+        std::cout << "  H " << H << ": " << pde.price << " vs " << exact << std::endl;
+        passed = passed && std::abs(pde.price - exact) < 2e-3;
+    }
+
+    // Spot already through the barrier
+    PDEResult out = pde_price(S0, r, sigma, T, PayoffSpec{100.0, true}, PDEOptions(), BarrierSpec{0.0, 100.0});
+    passed = passed && out.price == 0.0;
+    return make_result(passed);
+}
+
+TestResult test_batch_matches_single() {
+    std::cout << "Testing batched strikes against single solves..." << std::endl;
+
+    std::vector<PayoffSpec> payoffs;
+    for (double K = 60.0; K <= 150.0; K += 10.0) {
+        payoffs.push_back(PayoffSpec{K, true});
+        payoffs.push_back(PayoffSpec{K, false});
+    }
+    PDEOptions options;
+    options.space_nodes = 200;
+    options.time_steps = 100;
+    BarrierSpec barrier{40.0, 250.0};
+    std::vector<PDEResult> batch = pde_price(S0, r, sigma, T, payoffs, options, barrier);
+
+    bool passed = batch.size() == payoffs.size();
+    for (std::size_t j = 0; passed && j < payoffs.size(); ++j) {
+        PDEResult single = pde_price(S0, r, sigma, T, payoffs[j], options, barrier);
+        passed = single.price == batch[j].price && single.delta == batch[j].delta && single.gamma == batch[j].gamma;
+    }
+    return make_result(passed);
+}
+
+TestResult test_invalid_inputs() {
+    std::cout << "Testing input validation..." << std::endl;
+
+    auto rejected = [](auto build) {
+        try {
+            build();
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+
+    PayoffSpec payoff{100.0, true};
+    PDEOptions few_nodes;
+    few_nodes.space_nodes = 3;
+    PDEOptions too_many_rannacher;
+    too_many_rannacher.time_steps = 2;
+    too_many_rannacher.rannacher_steps = 3;
+
+    bool passed =
+        rejected([&] { pde_price(0.0, r, sigma, T, payoff); }) &&
+        rejected([&] { pde_price(S0, r, 0.0, T, payoff); }) &&
+        rejected([&] { pde_price(S0, r, sigma, 0.0, payoff); }) &&
+        rejected([&] { pde_price(S0, -0.01, sigma, T, payoff); }) &&
+        rejected([&] { pde_price(S0, r, sigma, T, PayoffSpec{0.0, true}); }) &&
+        rejected([&] { pde_price(S0, r, sigma, T, std::vector<PayoffSpec>()); }) &&
+        rejected([&] { pde_price(S0, r, sigma, T, payoff, few_nodes); }) &&
+        rejected([&] { pde_price(S0, r, sigma, T, payoff, too_many_rannacher); }) &&
+        rejected([&] { pde_price(S0, r, sigma, T, payoff, PDEOptions(), BarrierSpec{120.0, 110.0}); }) &&
+        !rejected([&] { pde_price(S0, r, sigma, T, payoff, PDEOptions(), BarrierSpec{90.0, 110.0}); });
+    return make_result(passed);
+}
+
+int main() {
+    std::cout << "PDE Solver Test Suite" << std::endl;
+    std::cout << "=====================" << std::endl;
+    std::cout << std::endl;
+
+    TestResult bs_test = test_black_scholes();
+    TestResult convergence_test = test_convergence();
+    TestResult barrier_test = test_down_and_out();
+    TestResult batch_test = test_batch_matches_single();
+    TestResult invalid_test = test_invalid_inputs();
+
+    std::cout << std::endl;
+    print_test_result("Black-Scholes", bs_test);
+    print_test_result("Convergence", convergence_test);
+    print_test_result("Down-and-Out", barrier_test);
+    print_test_result("Batch Matches Single", batch_test);
+    print_test_result("Invalid Inputs", invalid_test);
+
+    int total_tests = 5;
+    int passed_tests = (bs_test.passed ? 1 : 0) +
+                       (convergence_test.passed ? 1 : 0) +
+                       (barrier_test.passed ? 1 : 0) +
+                       (batch_test.passed ? 1 : 0) +
+                       (invalid_test.passed ? 1 : 0);
+
+    std::cout << std::endl;
+    std::cout << "Passed: " << passed_tests << "/" << total_tests << std::endl;
+    return passed_tests == total_tests ? 0 : 1;
+}
@@ -6,6 +6,7 @@
 #include "../include/pricer.hpp"
 #include "../include/black_scholes.hpp"
 #include "../include/gbm.hpp"
+#include "../include/mixed_precision.hpp"
 
 /**
  * @brief Simple test framework for Monte Carlo pricer
@@ -14,6 +15,7 @@
  * 1. Monte Carlo call prices are within 1% of Black-Scholes
  * 2. Monte Carlo put prices are within 1% of Black-Scholes
  * 3. Variance decreases as the number of paths increases
+ * 4. Mixed-precision simulation stays within Monte Carlo error of Black-Scholes
  */
 
 // Test parameters
@@ -53,7 +55,7 @@ TestResult test_call_accuracy() {
     MCResult mc_result = monte_carlo_price(gbm_params, K, true, n_paths, r);
     
     double error_percent = calculate_error_percent(bs_price, mc_result.price);
-    bool passed = error_percent <= tolerance;
+    bool passed = error_percent <= tolerance * 100.0; // error_percent is in percent
     
     TestResult result;
     result.passed = passed;
@@ -82,7 +84,7 @@ TestResult test_put_accuracy() {
     MCResult mc_result = monte_carlo_price(gbm_params, K, false, n_paths, r);
     
     double error_percent = calculate_error_percent(bs_price, mc_result.price);
-    bool passed = error_percent <= tolerance;
+    bool passed = error_percent <= tolerance * 100.0; // error_percent is in percent
     
     TestResult result;
     result.passed = passed;
@@ -182,6 +184,38 @@ TestResult test_standard_error_scaling() {
     return result;
 }
 
+// Test mixed-precision (float32 path) accuracy
+TestResult test_mixed_precision_accuracy() {
+    std::cout << "Testing mixed-precision accuracy..." << std::endl;
+    
+    GBMParams gbm_params = {S0, sigma, T, 52};
+    const int paths = 200000;
+    
+    double bs_price = bs_call(S0, K, r, sigma, T);
+    MCResult reference = monte_carlo_price_policy<DoublePrecision>(gbm_params, K, true, paths, r, 99);
+    MCResult mixed = monte_carlo_price_policy<MixedPrecision>(gbm_params, K, true, paths, r, 99);
+    MCResult compensated = monte_carlo_price_policy<CompensatedMixedPrecision>(gbm_params, K, true, paths, r, 99);
+    MCResult seeded = monte_carlo_price(gbm_params, K, true, paths, r, 99);
+    
+    // Both estimates must agree with Black-Scholes to within 4 standard errors;
+    // compensation only changes rounding, so it must match the plain sum closely.
+    // The double policy draws the seeded pricer's paths, so its error must
+    // match that pricer's (unbiased) error up to rounding
+    bool passed = std::abs(reference.price - bs_price) < 4.0 * reference.stderr &&
+                  std::abs(mixed.price - bs_price) < 4.0 * mixed.stderr &&
+                  std::abs(compensated.price - mixed.price) < 1e-9 * bs_price &&
+                  std::abs(reference.stderr - seeded.stderr) < 1e-9 * seeded.stderr;
+    
+    TestResult result;
+    result.passed = passed;
+    result.message = passed ? "PASSED" : "FAILED";
+    result.expected = bs_price;
+    result.actual = mixed.price;
+    result.error_percent = calculate_error_percent(bs_price, mixed.price);
+    
+    return result;
+}
+
 // Print test result
 void print_test_result(const std::string& test_name, const TestResult& result) {
     std::cout << std::endl;
@@ -218,19 +252,22 @@ int main() {
     TestResult put_test = test_put_accuracy();
     TestResult variance_test = test_variance_convergence();
     TestResult stderr_test = test_standard_error_scaling();
+    TestResult mixed_test = test_mixed_precision_accuracy();
     
     // Print results
     print_test_result("Call Option Accuracy", call_test);
     print_test_result("Put Option Accuracy", put_test);
     print_test_result("Variance Convergence", variance_test);
     print_test_result("Standard Error Scaling", stderr_test);
+    print_test_result("Mixed Precision Accuracy", mixed_test);
     
     // Summary
-    int total_tests = 4;
+    int total_tests = 5;
     int passed_tests = (call_test.passed ? 1 : 0) + 
                       (put_test.passed ? 1 : 0) + 
                       (variance_test.passed ? 1 : 0) + 
-                      (stderr_test.passed ? 1 : 0);
+                      (stderr_test.passed ? 1 : 0) +
+                      (mixed_test.passed ? 1 : 0);
     
     std::cout << "=== Test Summary ===" << std::endl;
     std::cout << "Passed: " << passed_tests << "/" << total_tests << std::endl;
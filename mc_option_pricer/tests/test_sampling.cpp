@@ -0,0 +1,211 @@
+#include <iostream>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../include/stratified_sampling.hpp"
+#include "../include/black_scholes.hpp"
+#include "../include/random_utils.hpp"
+#include "test_util.hpp"
+
+/**
+ * @brief Tests for stratified and Latin hypercube sampling
+ *
+ * This test suite verifies:
+ * 1. inverse_normal_cdf inverts the normal CDF to machine precision
+ * 2. inverse_normal_cdf stays finite at probabilities rounded onto 0 and 1
+ * 3. Stratified estimates match Black-Scholes with a much smaller error
+ * 4. The stratified standard error matches the spread across seeds
+ * 5. Latin hypercube estimates match Black-Scholes with a smaller error
+ * 6. Estimates are bit-identical on any thread count
+ * 7. Too few paths per stratum or replication are rejected
+ */
+
+const GBMParams params = {100.0, 0.2, 1.0, 12};
+const double K = 105.0;
+const double r = 0.05;
+
+SamplingOptions latin_hypercube() {
+    SamplingOptions options;
+    options.scheme = SamplingScheme::LatinHypercube;
+    return options;
+}
+
+TestResult test_inverse_normal() {
+    std::cout << "Testing the inverse normal CDF..." << std::endl;
+
+    // Round trip through erfc, which keeps its relative precision in the tail
+    bool passed = inverse_normal_cdf(0.5) == 0.0;
+    for (double u : {1e-300, 1e-12, 0.001, 0.02425, 0.1, 0.3, 0.7, 0.975, 0.999999}) {
+        double z = inverse_normal_cdf(u);
+        passed = passed && std::abs(0.5 * std::erfc(-z / std::sqrt(2.0)) - u) <= 1e-12 * u;
+    }
+    for (double u : {0.001, 0.02425, 0.1, 0.3}) {
+        passed = passed && std::abs(inverse_normal_cdf(1.0 - u) + inverse_normal_cdf(u)) < 1e-12;
+    }
+    return make_result(passed);
+}
+
+TestResult test_inverse_normal_edges() {
+    std::cout << "Testing the inverse normal CDF at the edges..." << std::endl;
+
+    // The top stratum of 1024 rounds onto 1 for u within half an ulp of 1
+    double top = (1023.0 + (1.0 - std::ldexp(1.0, -45))) / 1024.0;
+    double z_one = inverse_normal_cdf(1.0);
+    double z_zero = inverse_normal_cdf(0.0);
+    std::cout << "  N^-1(0) = " << z_zero << ", N^-1(1) = " << z_one << std::endl;
+
+    bool passed = top == 1.0 && std::isfinite(z_one) && std::isfinite(z_zero) && z_one > 8.0 &&
+                  z_zero < -37.0 && inverse_normal_cdf(top) == z_one &&
+                  inverse_normal_cdf(std::nextafter(1.0, 0.0)) == z_one;
+    return make_result(passed);
+}
+
+TestResult test_stratified_accuracy() {
+    std::cout << "Testing stratified estimates..." << std::endl;
+
+    PricingContext context(2, 1);
+    double bs_price = bs_call(params.S0, K, r, params.sigma, params.T);
+
+    bool passed = true;
+    for (int steps : {1, 12}) {
+        GBMParams p = params;
+        p.steps = steps;
+        PricingPlan plan(p, r, PayoffSpec{K, true}, EngineOptions{40000, 3});
+        MCResult plain = context.run(plan);
+        MCResult stratified = stratified_run(context, plan, SamplingOptions());
+        double reduction = (plain.stderr / stratified.stderr) * (plain.stderr / stratified.stderr);
+        std::cout << "  steps " << steps << ": " << stratified.price << " +/- " << stratified.stderr
+                  << " (variance reduction " << reduction << ")" << std::endl;
+        passed = passed && std::abs(stratified.price - bs_price) < 4.0 * stratified.stderr &&
+                 reduction > 100.0;
+    }
+    return make_result(passed);
+}
+
+TestResult test_stratified_stderr() {
+    std::cout << "Testing the stratified standard error..." << std::endl;
+
+    // Spread of independent estimates against the reported stderr
+    PricingContext context(1, 1);
+    SamplingOptions options;
+    options.strata = 64;
+    const int n_seeds = 40;
+    std::vector<double> prices;
+    double reported = 0.0;
+    for (int seed = 0; seed < n_seeds; ++seed) {
+        PricingPlan plan(params, r, PayoffSpec{K, false}, EngineOptions{640, static_cast<std::uint64_t>(seed)});
+        MCResult result = stratified_run(context, plan, options);
+        prices.push_back(result.price);
+        reported += result.stderr / n_seeds;
+    }
+    double mean = 0.0;
+    for (double price : prices) {
+        mean += price / n_seeds;
+    }
+    double spread = 0.0;
+    for (double price : prices) {
+        spread += (price - mean) * (price - mean) / (n_seeds - 1);
+    }
+    double empirical = std::sqrt(spread);
+    std::cout << "  reported " << reported << ", empirical " << empirical << std::endl;
+
+    bool passed = empirical > 0.7 * reported && empirical < 1.4 * reported &&
+                  std::abs(mean - bs_put(params.S0, K, r, params.sigma, params.T)) < 4.0 * empirical / std::sqrt(n_seeds);
+    return make_result(passed);
+}
+
+TestResult test_latin_hypercube() {
+    std::cout << "Testing Latin hypercube estimates..." << std::endl;
+
+    PricingContext context(2, 1);
+    PricingPlan plan(params, r, PayoffSpec{K, true}, EngineOptions{40000, 9});
+    MCResult plain = context.run(plan);
+    MCResult lhs = stratified_run(context, plan, latin_hypercube());
+    double reduction = (plain.stderr / lhs.stderr) * (plain.stderr / lhs.stderr);
+    std::cout << "  " << lhs.price << " +/- " << lhs.stderr << " (variance reduction " << reduction << ")"
+              << std::endl;
+
+    double bs_price = bs_call(params.S0, K, r, params.sigma, params.T);
+    bool passed = std::abs(lhs.price - bs_price) < 4.0 * lhs.stderr && reduction > 2.0;
+    return make_result(passed);
+}
+
+TestResult test_thread_count_independence() {
+    std::cout << "Testing thread-count independence..." << std::endl;
+
+    PricingPlan plan(params, r, PayoffSpec{K, true}, EngineOptions{10001, 4});
+    PricingContext single(1, 1);
+    PricingContext multi(3, 1);
+
+    MCResult a = stratified_run(single, plan, SamplingOptions());
+    MCResult b = stratified_run(multi, plan, SamplingOptions());
+    MCResult c = stratified_run(single, plan, latin_hypercube());
+    MCResult d = stratified_run(multi, plan, latin_hypercube());
+
+    bool passed = a.price == b.price && a.stderr == b.stderr && c.price == d.price && c.stderr == d.stderr;
+    return make_result(passed);
+}
+
+TestResult test_invalid_options() {
+    std::cout << "Testing option validation..." << std::endl;
+
+    PricingContext context(1, 1);
+    PricingPlan plan(params, r, PayoffSpec{K, true}, EngineOptions{1000, 1});
+
+    auto rejected = [&](const SamplingOptions& options) {
+        try {
+            stratified_run(context, plan, options);
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+
+    SamplingOptions crowded;
+    crowded.strata = 501;
+    SamplingOptions single_cube = latin_hypercube();
+    single_cube.replications = 1;
+
+    SamplingOptions ok;
+    ok.strata = 500;
+
+    bool passed = rejected(crowded) && rejected(single_cube) && !rejected(ok) && !rejected(latin_hypercube());
+    return make_result(passed);
+}
+
+int main() {
+    std::cout << "Sampling Test Suite" << std::endl;
+    std::cout << "===================" << std::endl;
+    std::cout << std::endl;
+
+    TestResult inverse_test = test_inverse_normal();
+    TestResult edges_test = test_inverse_normal_edges();
+    TestResult stratified_test = test_stratified_accuracy();
+    TestResult stderr_test = test_stratified_stderr();
+    TestResult lhs_test = test_latin_hypercube();
+    TestResult threads_test = test_thread_count_independence();
+    TestResult invalid_test = test_invalid_options();
+
+    std::cout << std::endl;
+    print_test_result("Inverse Normal", inverse_test);
+    print_test_result("Inverse Normal Edges", edges_test);
+    print_test_result("Stratified Accuracy", stratified_test);
+    print_test_result("Stratified Stderr", stderr_test);
+    print_test_result("Latin Hypercube", lhs_test);
+    print_test_result("Thread Count Independence", threads_test);
+    print_test_result("Invalid Options", invalid_test);
+
+    int total_tests = 7;
+    int passed_tests = (inverse_test.passed ? 1 : 0) +
+                       (edges_test.passed ? 1 : 0) +
+                       (stratified_test.passed ? 1 : 0) +
+                       (stderr_test.passed ? 1 : 0) +
+                       (lhs_test.passed ? 1 : 0) +
+                       (threads_test.passed ? 1 : 0) +
+                       (invalid_test.passed ? 1 : 0);
+
+    std::cout << std::endl;
+    std::cout << "Passed: " << passed_tests << "/" << total_tests << std::endl;
+    return passed_tests == total_tests ? 0 : 1;
+}
@@ -0,0 +1,171 @@
+#include <iostream>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "../include/scenario_grid.hpp"
+#include "../include/black_scholes.hpp"
+#include "test_util.hpp"
+
+/**
+ * @brief Tests for scenario grid revaluation
+ *
+ * This test suite verifies:
+ * 1. Every scenario of a spot x vol x rate cube matches Black-Scholes
+ * 2. Each cube entry equals a one-point revaluation at its shocked inputs
+ * 3. Cubes are bit-identical on any thread count, including the split
+ *    across scenarios when there are fewer path blocks than threads
+ * 4. Invalid or oversized grids and corrected plans are rejected
+ */
+
+const GBMParams params = {100.0, 0.2, 1.0, 12};
+const double K = 100.0;
+const double r = 0.05;
+
+ScenarioGrid stress_grid() {
+    ScenarioGrid grid;
+    grid.spot_shocks = {-0.2, -0.1, 0.0, 0.1, 0.2};
+    grid.vol_shocks = {-0.05, 0.0, 0.1};
+    grid.rate_shocks = {-0.02, 0.0, 0.01};
+    return grid;
+}
+
+TestResult test_black_scholes_cube() {
+    std::cout << "Testing the cube against Black-Scholes..." << std::endl;
+
+    PricingContext context(2, 1);
+    bool passed = true;
+    for (bool call : {true, false}) {
+        PricingPlan plan(params, r, PayoffSpec{K, call}, EngineOptions{100000, 3});
+        ScenarioCube cube = revalue_scenarios(context, plan, stress_grid());
+        passed = passed && cube.prices.size() == 45;
+        int outside = 0;
+        for (std::size_t i = 0; i < cube.spots.size(); ++i) {
+            for (std::size_t j = 0; j < cube.vols.size(); ++j) {
+                for (std::size_t k = 0; k < cube.rates.size(); ++k) {
+                    double bs = call ? bs_call(cube.spots[i], K, cube.rates[k], cube.vols[j], params.T)
+                                     : bs_put(cube.spots[i], K, cube.rates[k], cube.vols[j], params.T);
+                    if (std::abs(cube.at(i, j, k).price - bs) >= 4.0 * cube.at(i, j, k).stderr) {
+                        ++outside;
+                    }
+                }
+            }
+        }
+        std::cout << "  " << (call ? "call" : "put ") << ": " << outside
+                  << " of 45 scenarios outside 4 standard errors" << std::endl;
+        passed = passed && outside == 0;
+    }
+    return make_result(passed);
+}
+
+TestResult test_single_points() {
+    std::cout << "Testing entries against one-point revaluations..." << std::endl;
+
+    PricingContext context(2, 1);
+    ScenarioGrid grid = stress_grid();
+    PricingPlan plan(params, r, PayoffSpec{K, true}, EngineOptions{5000, 4, 0.3});
+    ScenarioCube cube = revalue_scenarios(context, plan, grid);
+
+    bool passed = true;
+    for (std::size_t i : {0, 3}) {
+        for (std::size_t j : {0, 2}) {
+            for (std::size_t k : {1, 2}) {
+                GBMParams shocked = params;
+                shocked.S0 = cube.spots[i];
+                shocked.sigma = cube.vols[j];
+                PricingPlan point(shocked, cube.rates[k], PayoffSpec{K, true}, EngineOptions{5000, 4, 0.3});
+                MCResult single = revalue_scenarios(context, point, ScenarioGrid()).prices.front();
+                passed = passed && single.price == cube.at(i, j, k).price &&
+                         single.stderr == cube.at(i, j, k).stderr;
+            }
+        }
+    }
+    return make_result(passed);
+}
+
+TestResult test_thread_count_independence() {
+    std::cout << "Testing thread-count independence..." << std::endl;
+
+    bool passed = true;
+    // 300 paths are two path blocks, so four threads also split the scenarios
+    for (std::int64_t n_paths : {300, 20001}) {
+        PricingPlan plan(params, r, PayoffSpec{110.0, false}, EngineOptions{n_paths, 5});
+        PricingContext single(1, 1);
+        ScenarioCube reference = revalue_scenarios(single, plan, stress_grid());
+        for (int threads : {3, 4}) {
+            PricingContext multi(threads, 1);
+            ScenarioCube cube = revalue_scenarios(multi, plan, stress_grid());
+            for (std::size_t s = 0; s < cube.prices.size(); ++s) {
+                passed = passed && cube.prices[s].price == reference.prices[s].price &&
+                         cube.prices[s].stderr == reference.prices[s].stderr;
+            }
+        }
+    }
+    return make_result(passed);
+}
+
+TestResult test_invalid_grids() {
+    std::cout << "Testing grid validation..." << std::endl;
+
+    PricingContext context(1, 1);
+    PricingPlan plan(params, r, PayoffSpec{K, true}, EngineOptions{1000, 1});
+
+    auto rejected = [&](const ScenarioGrid& grid, const PricingPlan& target) {
+        try {
+            revalue_scenarios(context, target, grid);
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+
+    ScenarioGrid empty_axis;
+    empty_axis.vol_shocks.clear();
+    ScenarioGrid negative_spot;
+    negative_spot.spot_shocks = {-1.0};
+    ScenarioGrid negative_vol;
+    negative_vol.vol_shocks = {-0.25};
+    ScenarioGrid not_finite;
+    not_finite.rate_shocks = {NAN};
+    // 21^3 = 9261 scenarios exceed kMaxReductionSums
+    ScenarioGrid oversized;
+    oversized.spot_shocks.assign(21, 0.0);
+    oversized.vol_shocks.assign(21, 0.0);
+    oversized.rate_shocks.assign(21, 0.0);
+
+    EngineOptions corrected{2 * kCorrectionBatchPaths, 1};
+    corrected.moment_matching = true;
+    PricingPlan corrected_plan(params, r, PayoffSpec{K, true}, corrected);
+
+    bool passed = rejected(empty_axis, plan) && rejected(negative_spot, plan) && rejected(negative_vol, plan) &&
+                  rejected(not_finite, plan) && rejected(oversized, plan) &&
+                  rejected(ScenarioGrid(), corrected_plan) &&
+                  !rejected(ScenarioGrid(), plan);
+    return make_result(passed);
+}
+
+int main() {
+    std::cout << "Scenario Grid Test Suite" << std::endl;
+    std::cout << "========================" << std::endl;
+    std::cout << std::endl;
+
+    TestResult black_scholes_test = test_black_scholes_cube();
+    TestResult points_test = test_single_points();
+    TestResult threads_test = test_thread_count_independence();
+    TestResult invalid_test = test_invalid_grids();
+
+    std::cout << std::endl;
+    print_test_result("Black-Scholes Cube", black_scholes_test);
+    print_test_result("Single Points", points_test);
+    print_test_result("Thread Count Independence", threads_test);
+    print_test_result("Invalid Grids", invalid_test);
+
+    int total_tests = 4;
+    int passed_tests = (black_scholes_test.passed ? 1 : 0) +
+                       (points_test.passed ? 1 : 0) +
+                       (threads_test.passed ? 1 : 0) +
+                       (invalid_test.passed ? 1 : 0);
+
+    std::cout << std::endl;
+    std::cout << "Passed: " << passed_tests << "/" << total_tests << std::endl;
+    return passed_tests == total_tests ? 0 : 1;
+}
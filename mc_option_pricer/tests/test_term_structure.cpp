@@ -0,0 +1,160 @@
+#include <iostream>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "../include/term_structure.hpp"
+#include "../include/black_scholes.hpp"
+#include "test_util.hpp"
+
+/**
+ * @brief Tests for rate and volatility term structures
+ *
+ * This test suite verifies:
+ * 1. Curve values and exact integrals of piecewise-constant and linear curves
+ * 2. Flat curves reproduce the PricingPlan of the same inputs
+ * 3. Prices under term structures match the closed form, with knots on
+ *    and off the step grid
+ * 4. Prices are bit-identical on any thread count
+ * 5. Invalid curves and inputs are rejected
+ */
+
+bool near(double a, double b) {
+    return std::abs(a - b) < 1e-12;
+}
+
+TestResult test_curves() {
+    std::cout << "Testing curve values and integrals..." << std::endl;
+
+    TermCurve steps = TermCurve::piecewise_constant({0.5, 1.0}, {0.1, 0.3});
+    TermCurve ramp = TermCurve::linear({0.0, 1.0}, {0.1, 0.3});
+
+    bool passed = near(steps.value(0.5), 0.1) && near(steps.value(0.75), 0.3) && near(steps.value(2.0), 0.3) &&
+                  near(steps.integral(0.25, 0.75), 0.25 * 0.1 + 0.25 * 0.3) &&
+                  near(steps.integral_of_square(0.0, 2.0), 0.5 * 0.01 + 1.5 * 0.09) &&
+                  near(ramp.value(0.25), 0.15) && near(ramp.value(-1.0), 0.1) &&
+                  near(ramp.integral(0.0, 2.0), 0.2 + 0.3) &&
+                  // int_0^1 (0.1 + 0.2 t)^2 dt = 0.01 + 0.02 + 0.04 / 3
+                  near(ramp.integral_of_square(0.0, 1.0), 0.03 + 0.04 / 3.0) &&
+                  near(TermCurve::flat(0.2).integral_of_square(0.3, 0.7), 0.4 * 0.04);
+    return make_result(passed);
+}
+
+TestResult test_flat_curves() {
+    std::cout << "Testing flat curves against PricingPlan..." << std::endl;
+
+    PricingContext context(2, 1);
+    TermStructureModel model{100.0, 1.0, 52, TermCurve::flat(0.05), TermCurve::flat(0.2)};
+    GBMParams params = {100.0, 0.2, 1.0, 52};
+
+    bool passed = true;
+    for (bool call : {true, false}) {
+        PayoffSpec payoff{105.0, call};
+        EngineOptions engine{20000, 3};
+        MCResult term = TermStructurePlan(model, payoff, engine).run(context);
+        MCResult flat = context.run(PricingPlan(params, 0.05, payoff, engine));
+        // Same normals; the tables differ from the folded constants in rounding only
+        passed = passed && std::abs(term.price - flat.price) < 1e-9 && std::abs(term.stderr - flat.stderr) < 1e-9 &&
+                 near(bs_term_structure(model, payoff), call ? bs_call(100.0, 105.0, 0.05, 0.2, 1.0)
+                                                             : bs_put(100.0, 105.0, 0.05, 0.2, 1.0));
+    }
+    return make_result(passed);
+}
+
+TestResult test_term_structure_prices() {
+    std::cout << "Testing prices against the term-structure closed form..." << std::endl;
+
+    PricingContext context(2, 1);
+    // Knots at 0.3 and 0.7 fall between the grid points of 12 steps
+    TermStructureModel models[] = {
+        {100.0, 1.0, 12, TermCurve::piecewise_constant({0.3, 0.7}, {0.01, 0.06}),
+         TermCurve::piecewise_constant({0.25, 0.5, 0.75, 1.0}, {0.4, 0.1, 0.25, 0.15})},
+        {100.0, 2.0, 8, TermCurve::linear({0.0, 2.0}, {0.02, 0.06}), TermCurve::linear({0.0, 0.7, 2.0}, {0.1, 0.35, 0.2})},
+    };
+
+    bool passed = true;
+    for (const TermStructureModel& model : models) {
+        for (PayoffSpec payoff : {PayoffSpec{90.0, true}, PayoffSpec{110.0, true}, PayoffSpec{100.0, false}}) {
+            MCResult mc = TermStructurePlan(model, payoff, EngineOptions{200000, 4}).run(context);
+            double reference = bs_term_structure(model, payoff);
+            std::cout << "  T " << model.T << " K " << payoff.K << (payoff.call ? " call: " : " put: ")
+                      << mc.price << " +/- " << mc.stderr << " (closed form " << reference << ")" << std::endl;
+            passed = passed && std::abs(mc.price - reference) < 4.0 * mc.stderr;
+        }
+    }
+    return make_result(passed);
+}
+
+TestResult test_thread_count_independence() {
+    std::cout << "Testing thread-count independence..." << std::endl;
+
+    TermStructureModel model{100.0, 1.0, 24, TermCurve::linear({0.0, 1.0}, {0.03, 0.05}),
+                             TermCurve::piecewise_constant({0.5, 1.0}, {0.3, 0.2})};
+    TermStructurePlan plan(model, PayoffSpec{100.0, true}, EngineOptions{10001, 5});
+    PricingContext single(1, 1);
+    PricingContext multi(3, 1);
+    MCResult a = plan.run(single);
+    MCResult b = plan.run(multi);
+    return make_result(a.price == b.price && a.stderr == b.stderr);
+}
+
+TestResult test_invalid_inputs() {
+    std::cout << "Testing input validation..." << std::endl;
+
+    auto rejected = [](auto build) {
+        try {
+            build();
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+
+    TermCurve rate = TermCurve::flat(0.05);
+    TermCurve vol = TermCurve::flat(0.2);
+    PayoffSpec payoff{100.0, true};
+    EngineOptions engine{1000, 1};
+    EngineOptions shifted{1000, 1, 0.5};
+
+    bool passed =
+        rejected([] { TermCurve::piecewise_constant({}, {}); }) &&
+        rejected([] { TermCurve::piecewise_constant({0.5, 0.5}, {0.1, 0.2}); }) &&
+        rejected([] { TermCurve::piecewise_constant({0.0}, {0.1}); }) &&
+        rejected([] { TermCurve::linear({0.0, 1.0}, {0.1}); }) &&
+        rejected([] { TermCurve::linear({0.0, 1.0}, {0.1, NAN}); }) &&
+        rejected([&] { TermStructurePlan({100.0, 1.0, 12, rate, TermCurve::flat(-0.1)}, payoff, engine); }) &&
+        rejected([&] { TermStructurePlan({100.0, 1.0, 12, TermCurve::flat(-0.01), vol}, payoff, engine); }) &&
+        rejected([&] { TermStructurePlan({100.0, 0.0, 12, rate, vol}, payoff, engine); }) &&
+        rejected([&] { TermStructurePlan({100.0, 1.0, 12, rate, vol}, payoff, shifted); }) &&
+        !rejected([&] { TermStructurePlan({100.0, 1.0, 12, rate, vol}, payoff, engine); });
+    return make_result(passed);
+}
+
+int main() {
+    std::cout << "Term Structure Test Suite" << std::endl;
+    std::cout << "=========================" << std::endl;
+    std::cout << std::endl;
+
+    TestResult curves_test = test_curves();
+    TestResult flat_test = test_flat_curves();
+    TestResult prices_test = test_term_structure_prices();
+    TestResult threads_test = test_thread_count_independence();
+    TestResult invalid_test = test_invalid_inputs();
+
+    std::cout << std::endl;
+    print_test_result("Curves", curves_test);
+    print_test_result("Flat Curves", flat_test);
+    print_test_result("Term Structure Prices", prices_test);
+    print_test_result("Thread Count Independence", threads_test);
+    print_test_result("Invalid Inputs", invalid_test);
+
+    int total_tests = 5;
+    int passed_tests = (curves_test.passed ? 1 : 0) +
+                       (flat_test.passed ? 1 : 0) +
+                       (prices_test.passed ? 1 : 0) +
+                       (threads_test.passed ? 1 : 0) +
+                       (invalid_test.passed ? 1 : 0);
+
+    std::cout << std::endl;
+    std::cout << "Passed: " << passed_tests << "/" << total_tests << std::endl;
+    return passed_tests == total_tests ? 0 : 1;
+}
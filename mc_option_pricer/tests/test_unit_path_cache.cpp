@@ -0,0 +1,144 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../include/unit_path_cache.hpp"
+#include "../include/black_scholes.hpp"
+#include "test_util.hpp"
+
+/**
+ * @brief Tests for the unit-spot path cache
+ *
+ * This test suite verifies:
+ * 1. Cached prices are bit-identical to fresh simulations for any spot and strike
+ * 2. Several payoffs priced in one pass match individual prices
+ * 3. Spot and strike moves hit the cache; model changes miss it; LRU eviction
+ * 4. Shifted and batch-corrected plans are rejected
+ */
+
+const GBMParams params = {100.0, 0.2, 1.0, 52};
+const double r = 0.05;
+
+PricingPlan plan_at(double S0, const PayoffSpec& payoff, std::int64_t n_paths = 20001) {
+    GBMParams p = params;
+    p.S0 = S0;
+    return PricingPlan(p, r, payoff, EngineOptions{n_paths, 11});
+}
+
+TestResult test_matches_simulation() {
+    std::cout << "Testing cached prices against fresh simulations..." << std::endl;
+
+    UnitPathCache cache;
+    PricingContext single(1, 1);
+    PricingContext multi(3, 1);
+
+    bool passed = true;
+    for (double S0 : {80.0, 100.0, 123.45}) {
+        for (PayoffSpec payoff : {PayoffSpec{90.0, true}, PayoffSpec{110.0, false}}) {
+            PricingPlan plan = plan_at(S0, payoff);
+            MCResult simulated = single.run(plan);
+            MCResult cached = cache.price(multi, plan);
+            passed = passed && cached.price == simulated.price && cached.stderr == simulated.stderr;
+        }
+    }
+    return make_result(passed);
+}
+
+TestResult test_strike_batch() {
+    std::cout << "Testing several payoffs in one pass..." << std::endl;
+
+    UnitPathCache cache;
+    PricingContext context(2, 1);
+    std::vector<PayoffSpec> payoffs = {{80.0, true}, {100.0, true}, {120.0, true}, {90.0, false}, {100.0, false}};
+    PricingPlan plan = plan_at(100.0, payoffs[0], 200000);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<MCResult> batch = cache.price(context, plan, payoffs);
+    auto simulated = std::chrono::steady_clock::now();
+    std::vector<MCResult> again = cache.price(context, plan, payoffs);
+    auto repriced = std::chrono::steady_clock::now();
+    std::cout << "  5 strikes: " << std::chrono::duration<double, std::milli>(simulated - start).count()
+              << " ms with simulation, " << std::chrono::duration<double, std::milli>(repriced - simulated).count()
+              << " ms from the cache" << std::endl;
+
+    bool passed = batch.size() == payoffs.size();
+    for (std::size_t j = 0; j < payoffs.size() && passed; ++j) {
+        MCResult single = cache.price(context, plan_at(100.0, payoffs[j], 200000));
+        double bs = payoffs[j].call ? bs_call(params.S0, payoffs[j].K, r, params.sigma, params.T)
+                                    : bs_put(params.S0, payoffs[j].K, r, params.sigma, params.T);
+        passed = passed && batch[j].price == single.price && batch[j].stderr == single.stderr &&
+                 again[j].price == batch[j].price && std::abs(batch[j].price - bs) < 4.0 * batch[j].stderr;
+    }
+    return make_result(passed);
+}
+
+TestResult test_cache_keys() {
+    std::cout << "Testing cache keys and eviction..." << std::endl;
+
+    UnitPathCache cache(2);
+    PricingContext context(1, 1);
+    cache.price(context, plan_at(100.0, PayoffSpec{100.0, true}));
+    cache.price(context, plan_at(101.5, PayoffSpec{100.0, true}));
+    cache.price(context, plan_at(99.0, PayoffSpec{95.0, false}));
+    CacheStats moves = cache.stats();
+
+    // A different volatility is a different path set
+    GBMParams shocked = params;
+    shocked.sigma = 0.25;
+    cache.price(context, PricingPlan(shocked, r, PayoffSpec{100.0, true}, EngineOptions{20001, 11}));
+    cache.price(context, plan_at(100.0, PayoffSpec{100.0, true}, 30000));
+    CacheStats after = cache.stats();
+
+    bool passed = moves.hits == 2 && moves.misses == 1 && after.misses == 3 && after.evictions == 1 &&
+                  cache.size() == 2;
+    return make_result(passed);
+}
+
+TestResult test_rejected_plans() {
+    std::cout << "Testing plan validation..." << std::endl;
+
+    UnitPathCache cache;
+    PricingContext context(1, 1);
+    auto rejected = [&](const EngineOptions& options) {
+        try {
+            cache.price(context, PricingPlan(params, r, PayoffSpec{100.0, true}, options));
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+
+    EngineOptions corrected{2 * kCorrectionBatchPaths, 1};
+    corrected.martingale_correction = true;
+    bool passed = rejected(EngineOptions{1000, 1, 0.5}) && rejected(corrected) && !rejected(EngineOptions{1000, 1});
+    return make_result(passed);
+}
+
+int main() {
+    std::cout << "Unit Path Cache Test Suite" << std::endl;
+    std::cout << "==========================" << std::endl;
+    std::cout << std::endl;
+
+    TestResult simulation_test = test_matches_simulation();
+    TestResult batch_test = test_strike_batch();
+    TestResult keys_test = test_cache_keys();
+    TestResult rejected_test = test_rejected_plans();
+
+    std::cout << std::endl;
+    print_test_result("Matches Simulation", simulation_test);
+    print_test_result("Strike Batch", batch_test);
+    print_test_result("Cache Keys", keys_test);
+    print_test_result("Rejected Plans", rejected_test);
+
+    int total_tests = 4;
+    int passed_tests = (simulation_test.passed ? 1 : 0) +
+                       (batch_test.passed ? 1 : 0) +
+                       (keys_test.passed ? 1 : 0) +
+                       (rejected_test.passed ? 1 : 0);
+
+    std::cout << std::endl;
+    std::cout << "Passed: " << passed_tests << "/" << total_tests << std::endl;
+    return passed_tests == total_tests ? 0 : 1;
+}
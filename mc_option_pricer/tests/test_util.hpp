@@ -0,0 +1,29 @@
+#ifndef TEST_UTIL_HPP
+#define TEST_UTIL_HPP
+
+#include <iostream>
+#include <string>
+
+/**
+ * @brief Pass/fail result shared by the test suites
+ *
+ * Each suite runs its tests, prints one line per result with
+ * print_test_result() and exits non-zero unless every test passed.
+ */
+struct TestResult {
+    bool passed;
+    std::string message;
+};
+
+inline TestResult make_result(bool passed) {
+    TestResult result;
+    result.passed = passed;
+    result.message = passed ? "PASSED" : "FAILED";
+    return result;
+}
+
+inline void print_test_result(const std::string& test_name, const TestResult& result) {
+    std::cout << "=== " << test_name << " === " << result.message << std::endl;
+}
+
+#endif // TEST_UTIL_HPP